@@ -0,0 +1,144 @@
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "AllocationCounter.h"
+#include "BenchReport.h"
+#include "OrderFlowGenerator.h"
+#include "Logger.h"
+
+// Allocations du tas par appel à process(), par type de message, sur un flux
+// OrderFlowGenerator. Exécutable lié à `alloc_hooks` (operator new / delete comptés).
+// Usage : Allocations [--orders N] [--map] [--reserve N] [--repeat R] [--json F]
+//   --orders N  : ordres de warm-up, puis autant d'ordres mesurés (défaut 200 000)
+//   --map       : carnets std::map (instruments non référencés) au lieu de l'échelle dense
+//   --reserve N : MatchingEngine::reserve(N) avant le warm-up
+//   --repeat R  : R passes sur le même flux, moteur neuf à chaque fois (défaut 1)
+//   --json F    : rapport JSON (allocations et octets par appel, par type de message)
+
+namespace {
+
+    struct Tally {
+        uint64_t calls = 0, allocations = 0, bytes = 0, worst = 0;
+
+        void add(const me::alloc::Counts& c) {
+            ++calls;
+            allocations += c.allocations;
+            bytes       += c.bytes;
+            if (c.allocations > worst) worst = c.allocations;
+        }
+
+        void report(me::BenchReport& r, const std::string& name) const {
+            double n = calls ? static_cast<double>(calls) : 1.0;
+            r.add(name + ".allocs_per_call", "allocs", false, allocations / n);
+            r.add(name + ".bytes_per_call",  "octets", false, bytes / n);
+        }
+    };
+
+    void print(const char* name, const Tally& t) {
+        double calls = t.calls ? static_cast<double>(t.calls) : 1.0;
+        std::cout << std::setfill(' ') << std::left << std::setw(12) << name << std::right
+                  << std::setw(10) << t.calls
+                  << std::setw(10) << t.allocations
+                  << std::fixed << std::setprecision(3)
+                  << std::setw(14) << t.allocations / calls
+                  << std::setw(14) << t.bytes / calls
+                  << std::setw(10) << t.worst << '\n';
+    }
+
+}
+
+int main(int argc, char** argv) {
+    me::setLoggingEnabled(false);
+
+    size_t      n       = 200000;
+    size_t      reserve = 0;
+    size_t      repeat  = 1;
+    bool        mapBook = false;
+    std::string json;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--orders") && i + 1 < argc) n = std::stoul(argv[++i]);
+        else if (!std::strcmp(argv[i], "--map"))             mapBook = true;
+        else if (!std::strcmp(argv[i], "--reserve") && i + 1 < argc) reserve = std::stoul(argv[++i]);
+        else if (!std::strcmp(argv[i], "--repeat") && i + 1 < argc)  repeat = std::max<size_t>(1, std::stoul(argv[++i]));
+        else if (!std::strcmp(argv[i], "--json") && i + 1 < argc)    json = argv[++i];
+        else {
+            std::cerr << "Argument inconnu : " << argv[i] << "\n";
+            return 1;
+        }
+    }
+    if (!me::alloc::hooksInstalled()) {
+        std::cerr << "operator new / delete non instrumentés (alloc_hooks non lié)\n";
+        return 1;
+    }
+
+    // Flux généré d'avance : le générateur et son moteur fantôme allouent, eux
+    using Gen = me::OrderFlowGenerator;
+    Gen                    gen;
+    me::MatchingEngine     shadow;
+    gen.registerInstruments(shadow);
+    std::vector<me::Order> flow;
+    flow.reserve(2 * n);
+    for (size_t i = 0; i < 2 * n; ++i) {
+        flow.push_back(gen.next());
+        shadow.process(flow.back(), [&](const me::MatchResult& r) { gen.observe(r); });
+    }
+
+    me::BenchReport report("Allocations");
+    report.setParam("orders", std::to_string(n));
+    report.setParam("book", mapBook ? "map" : "ladder");
+    report.setParam("reserve", std::to_string(reserve));
+    report.setParam("repeat", std::to_string(repeat));
+
+    // Une passe par moteur neuf : les compteurs sont déterministes, des passes
+    // identiques permettent à benchcmp une comparaison exacte
+    size_t results = 0;
+    auto   sink    = [&](const me::MatchResult&) { ++results; };
+    Tally  warmup, steady[Gen::kKinds], total;
+    for (size_t pass = 0; pass < repeat; ++pass) {
+        me::MatchingEngine engine;
+        if (!mapBook) gen.registerInstruments(engine);
+        if (reserve)  engine.reserve(reserve);
+        warmup = total = Tally{};
+        for (auto& t : steady) t = Tally{};
+        for (size_t i = 0; i < flow.size(); ++i) {
+            me::alloc::Scope scope;
+            engine.process(flow[i], sink);
+            auto delta = scope.delta();
+            if (i < n) {
+                warmup.add(delta);
+                continue;
+            }
+            steady[static_cast<size_t>(Gen::kindOf(flow[i]))].add(delta);
+            total.add(delta);
+        }
+        warmup.report(report, "warmup");
+        for (size_t k = 0; k < Gen::kKinds; ++k)
+            steady[k].report(report, Gen::toString(static_cast<Gen::Kind>(k)));
+        total.report(report, "total");
+    }
+
+    std::cout << "Allocations par process() (" << (mapBook ? "carnets std::map" : "échelle dense")
+              << ", " << n << " ordres de warm-up puis " << n << " mesurés)\n"
+              << std::left << std::setw(12) << "type" << std::right << std::setw(10) << "appels"
+              << std::setw(10) << "allocs"
+              << std::setw(14) << "allocs/appel" << std::setw(14) << "octets/appel"
+              << std::setw(10) << "pire" << '\n';
+    print("warm-up", warmup);
+    for (size_t k = 0; k < Gen::kKinds; ++k)
+        print(Gen::toString(static_cast<Gen::Kind>(k)), steady[k]);
+    print("total", total);
+
+    if (!json.empty()) {
+        try {
+            report.writeFile(json);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << "\n";
+            return 1;
+        }
+        std::cout << "Rapport JSON : " << json << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "BenchReport.h"
+#include "Journal.h"
+#include "Logger.h"
+#include "OrderFlowGenerator.h"
+
+// Coût de la durabilité par ordre : le même flux OrderFlowGenerator est traité
+// sans journal, puis journalisé (Journal::append avant chaque process()) à
+// chaque niveau de durabilité ; le surcoût est l'écart en ns par ordre.
+// Usage : Durability [--orders N] [--group G] [--interval US] [--sync-orders M]
+//                    [--dir D] [--repeat R] [--json F]
+//   --orders N      : ordres mesurés, après autant de warm-up (défaut 200 000)
+//   --group G       : ordres par msync en group commit (défaut 256)
+//   --interval US   : période du msync de fond en mode async (défaut 1000 µs)
+//   --sync-orders M : ordres mesurés en mode sync, un msync chacun (défaut 2 000)
+//   --dir D         : répertoire où créer le sous-répertoire privé du journal, seul
+//                     effacé ensuite (défaut : répertoire temporaire du système)
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double nsPerOrder(Clock::time_point t0, size_t n) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / static_cast<double>(n);
+}
+
+// Sous-répertoire créé par le bench dans le répertoire choisi : c'est le seul
+// qu'il efface, jamais le répertoire fourni par l'utilisateur
+struct PrivateDir {
+    explicit PrivateDir(const std::filesystem::path& parent)
+      : path(parent / ("me_durability_bench." + std::to_string(::getpid())))
+    {
+        std::filesystem::create_directories(parent);
+        if (!std::filesystem::create_directory(path))
+            throw std::runtime_error("Le répertoire « " + path.string() + " » existe déjà");
+    }
+    ~PrivateDir() {
+        std::error_code ec;
+        std::filesystem::remove_all(path, ec);
+    }
+    PrivateDir(const PrivateDir&)            = delete;
+    PrivateDir& operator=(const PrivateDir&) = delete;
+
+    std::filesystem::path path;
+};
+
+}
+
+int main(int argc, char** argv) {
+    me::setLoggingEnabled(false);
+
+    try {
+        size_t      n = 200000, syncOrders = 2000, repeat = 1;
+        std::string dir = std::filesystem::temp_directory_path().string();
+        std::string json;
+        me::Journal::Options base;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--orders" && i + 1 < argc)           n = std::stoul(argv[++i]);
+            else if (arg == "--group" && i + 1 < argc)       base.groupSize  = std::stoul(argv[++i]);
+            else if (arg == "--interval" && i + 1 < argc)    base.intervalUs = std::stoull(argv[++i]);
+            else if (arg == "--sync-orders" && i + 1 < argc) syncOrders = std::stoul(argv[++i]);
+            else if (arg == "--dir" && i + 1 < argc)         dir = argv[++i];
+            else if (arg == "--repeat" && i + 1 < argc)      repeat = std::max<size_t>(1, std::stoul(argv[++i]));
+            else if (arg == "--json" && i + 1 < argc)        json = argv[++i];
+            else
+                throw std::runtime_error("Argument inconnu : " + arg);
+        }
+
+        // Flux généré d'avance (un moteur fantôme tient à jour les ordres vivants)
+        me::OrderFlowGenerator gen;
+        me::MatchingEngine     shadow;
+        gen.registerInstruments(shadow);
+        std::vector<me::Order> warmup, measured;
+        for (size_t i = 0; i < 2 * n; ++i) {
+            auto& v = i < n ? warmup : measured;
+            v.push_back(gen.next());
+            shadow.process(v.back(), [&](const me::MatchResult& r) { gen.observe(r); });
+        }
+
+        PrivateDir work(dir);
+        size_t     results = 0;
+        auto       sink    = [&](const me::MatchResult&) { ++results; };
+
+        // Une passe : moteur neuf et warm-up hors chrono, puis `count` ordres mesurés,
+        // journalisés si `opts` est fourni (commit final compris dans la mesure)
+        struct Run { double ns; uint64_t syncs; uint64_t syncNs; };
+        auto run = [&](const me::Journal::Options* opts, size_t count) {
+            me::MatchingEngine engine;
+            gen.registerInstruments(engine);
+            for (auto const& o : warmup)
+                engine.process(o, sink);
+            if (!opts) {
+                auto t0 = Clock::now();
+                for (size_t i = 0; i < count; ++i)
+                    engine.process(measured[i], sink);
+                return Run{ nsPerOrder(t0, count), 0, 0 };
+            }
+            // journal neuf à chaque passe, dans le sous-répertoire privé
+            std::filesystem::path journalDir = work.path / "journal";
+            std::filesystem::remove_all(journalDir);
+            me::Journal journal(journalDir.string(), *opts);
+            uint64_t syncs0 = journal.syncs(), syncNs0 = journal.syncNs();
+            auto t0 = Clock::now();
+            for (size_t i = 0; i < count; ++i) {
+                journal.append(measured[i]);
+                engine.process(measured[i], sink);
+            }
+            if (opts->durability != me::Journal::Durability::None)
+                journal.commit();
+            double ns = nsPerOrder(t0, count);
+            journal.close();
+            return Run{ ns, journal.syncs() - syncs0, journal.syncNs() - syncNs0 };
+        };
+
+        me::BenchReport report("Durability");
+        report.setParam("orders", std::to_string(n));
+        report.setParam("group", std::to_string(base.groupSize));
+        report.setParam("interval_us", std::to_string(base.intervalUs));
+        report.setParam("repeat", std::to_string(repeat));
+
+        using D = me::Journal::Durability;
+        const D levels[] = { D::None, D::Async, D::Group, D::Sync };
+        for (size_t pass = 0; pass < repeat; ++pass) {
+            Run plain = run(nullptr, n);
+            report.add("process.ns_per_order", "ns", false, plain.ns);
+
+            if (pass + 1 == repeat)
+                std::cout << "Journal : " << n << " ordres (sync : " << std::min(syncOrders, n)
+                          << "), group commit " << base.groupSize << ", msync de fond toutes les "
+                          << base.intervalUs << " µs\n"
+                          << std::setfill(' ') << std::left << std::setw(10) << "niveau" << std::right
+                          << std::setw(12) << "ns/ordre" << std::setw(12) << "surcoût"
+                          << std::setw(10) << "msync" << std::setw(14) << "µs/msync" << '\n'
+                          << std::left << std::setw(10) << "aucun" << std::right << std::fixed
+                          << std::setprecision(1) << std::setw(12) << plain.ns << std::setw(12) << 0.0
+                          << std::setw(10) << 0 << std::setw(14) << "-" << '\n';
+
+            for (D level : levels) {
+                me::Journal::Options opts = base;
+                opts.durability = level;
+                size_t count = level == D::Sync ? std::min(syncOrders, n) : n;
+                Run r = run(&opts, count);
+                double overhead = r.ns - plain.ns;
+                std::string name = me::toString(level);
+                report.add(name + ".ns_per_order", "ns", false, r.ns);
+                report.add(name + ".overhead_ns", "ns", false, overhead);
+                if (pass + 1 < repeat)
+                    continue;
+                std::cout << std::left << std::setw(10) << name << std::right
+                          << std::setw(12) << r.ns << std::setw(12) << overhead
+                          << std::setw(10) << r.syncs << std::setw(14);
+                if (r.syncs) std::cout << r.syncNs / 1e3 / static_cast<double>(r.syncs);
+                else         std::cout << "-";
+                std::cout << '\n';
+            }
+        }
+        std::cout << "(surcoût : ns/ordre journalisé moins ns/ordre sans journal ; "
+                     "async : msync sur un thread de fond, hors du chemin de l'appelant)\n";
+
+        if (!json.empty()) {
+            report.writeFile(json);
+            std::cout << "Rapport JSON : " << json << "\n";
+        }
+        return 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Erreur fatale : " << e.what() << "\n";
+        return 1;
+    }
+}
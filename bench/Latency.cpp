@@ -0,0 +1,177 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BenchReport.h"
+#include "OrderFlowGenerator.h"
+#include "LatencyHistogram.h"
+#include "Logger.h"
+#include "PerfCounters.h"
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#include <x86intrin.h>
+#define ME_HAS_TSC 1
+#endif
+
+// Bench de latence : chaque appel à process() est chronométré individuellement
+// et rangé dans un histogramme par type de message, sur un flux OrderFlowGenerator.
+// Usage : Latency [--orders N] [--tsc] [--repeat R] [--json F]
+//   --orders N : nombre d'ordres mesurés (défaut 1 000 000, après autant de warm-up)
+//   --tsc      : horodatage au compteur de cycles (calibré sur steady_clock)
+//                plutôt qu'avec steady_clock
+//   --repeat R : R passes indépendantes (moteur neuf à chaque fois), 1 par défaut
+//   --json F   : rapport JSON, percentiles de chaque passe (à comparer avec benchcmp)
+
+namespace {
+
+#ifdef ME_HAS_TSC
+    // ns par cycle, mesuré sur ~50 ms
+    double calibrateTsc() {
+        auto     t0 = std::chrono::steady_clock::now();
+        uint64_t c0 = __rdtsc();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        uint64_t c1 = __rdtsc();
+        auto     t1 = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(c1 - c0);
+    }
+#endif
+
+    uint64_t steadyNs() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+}
+
+int main(int argc, char** argv) {
+    me::setLoggingEnabled(false);
+
+    size_t      n      = 1000000;
+    size_t      repeat = 1;
+    bool        useTsc = false;
+    std::string json;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--orders") && i + 1 < argc)      n = std::stoul(argv[++i]);
+        else if (!std::strcmp(argv[i], "--tsc"))                  useTsc = true;
+        else if (!std::strcmp(argv[i], "--repeat") && i + 1 < argc) repeat = std::max<size_t>(1, std::stoul(argv[++i]));
+        else if (!std::strcmp(argv[i], "--json") && i + 1 < argc)   json = argv[++i];
+        else {
+            std::cerr << "Argument inconnu : " << argv[i] << "\n";
+            return 1;
+        }
+    }
+#ifndef ME_HAS_TSC
+    if (useTsc) {
+        std::cerr << "--tsc : compteur de cycles indisponible, steady_clock utilisé\n";
+        useTsc = false;
+    }
+#endif
+
+    // 1) Flux de warm-up (pour peupler les carnets) et flux mesuré, générés hors chrono
+    //    (un moteur fantôme suit le flux pour que MODIFY / CANCEL visent des ordres vivants)
+    using Gen = me::OrderFlowGenerator;
+    Gen                gen;
+    me::MatchingEngine shadow;
+    gen.registerInstruments(shadow);
+    auto observe = [&](const me::MatchResult& r) { gen.observe(r); };
+
+    std::vector<me::Order> warmup, measured;
+    warmup.reserve(n);
+    measured.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        warmup.push_back(gen.next());
+        shadow.process(warmup.back(), observe);
+    }
+    for (size_t i = 0; i < n; ++i) {
+        measured.push_back(gen.next());
+        shadow.process(measured.back(), observe);
+    }
+
+    double nsPerTick = 1.0;
+#ifdef ME_HAS_TSC
+    if (useTsc) nsPerTick = calibrateTsc();
+#endif
+
+    me::BenchReport report("Latency");
+    report.setParam("orders", std::to_string(n));
+    report.setParam("clock", useTsc ? "tsc" : "steady_clock");
+    report.setParam("repeat", std::to_string(repeat));
+
+    // Chaque passe repart d'un moteur neuf ; le tableau affiché est celui de la dernière
+    for (size_t pass = 0; pass < repeat; ++pass) {
+        me::MatchingEngine eng;
+        gen.registerInstruments(eng);
+        size_t results = 0;
+        auto sink = [&](const me::MatchResult&) { ++results; };
+        for (auto const& o : warmup)
+            eng.process(o, sink);
+        results = 0;
+
+        // 2) Mesure : un horodatage avant / après chaque process()
+        me::LatencyHistogram hist[Gen::kKinds];
+        // compteurs matériels sur toute la boucle (lectures d'horloge comprises)
+        me::PerfCounters counters;
+        counters.start();
+        auto t0 = std::chrono::steady_clock::now();
+        for (auto const& o : measured) {
+            uint64_t begin, end;
+#ifdef ME_HAS_TSC
+            if (useTsc) {
+                // lfence / rdtscp : pas de réordonnancement autour de la zone mesurée
+                unsigned aux;
+                _mm_lfence();
+                begin = __rdtsc();
+                _mm_lfence();
+                eng.process(o, sink);
+                end   = __rdtscp(&aux);
+                _mm_lfence();
+            }
+            else
+#endif
+            {
+                begin = steadyNs();
+                eng.process(o, sink);
+                end   = steadyNs();
+            }
+            hist[static_cast<size_t>(Gen::kindOf(o))].record(static_cast<uint64_t>(static_cast<double>(end - begin) * nsPerTick));
+        }
+        double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        counters.stop();
+
+        // 3) Restitution
+        me::LatencyHistogram all;
+        for (size_t t = 0; t < Gen::kKinds; ++t) {
+            all.merge(hist[t]);
+            report.addLatency(Gen::toString(static_cast<Gen::Kind>(t)), hist[t]);
+        }
+        report.addLatency("total", all);
+        report.add("throughput", "ordres/s", true, static_cast<double>(n) / secs);
+        report.addCounters("process", counters, static_cast<double>(n), "ordre");
+        if (pass + 1 < repeat) {
+            std::cout << "Passe " << pass + 1 << " : p50 " << all.percentile(50) << " ns, p99 "
+                      << all.percentile(99) << " ns, p99.9 " << all.percentile(99.9) << " ns\n";
+            continue;
+        }
+
+        std::cout << "Latence de process() sur " << n << " ordres (" << (useTsc ? "TSC" : "steady_clock")
+                  << ", " << results << " résultats, " << secs << " s)\n";
+        me::LatencyHistogram::printHeader(std::cout);
+        for (size_t t = 0; t < Gen::kKinds; ++t)
+            hist[t].print(std::cout, Gen::toString(static_cast<Gen::Kind>(t)));
+        all.print(std::cout, "total");
+        counters.print(std::cout, static_cast<double>(n), "ordre");
+    }
+
+    if (!json.empty()) {
+        try {
+            report.writeFile(json);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << "\n";
+            return 1;
+        }
+        std::cout << "Rapport JSON : " << json << "\n";
+    }
+    return 0;
+}
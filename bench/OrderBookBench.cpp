@@ -0,0 +1,306 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "BenchReport.h"
+#include "OrderBook.h"
+#include "Logger.h"
+#include "PerfCounters.h"
+
+// Microbenchmarks par opération du carnet, pour chaque backend de niveaux
+// (MapLevels / LadderLevels), paramétrés par la profondeur (niveaux par côté)
+// et le nombre d'ordres par niveau. Chaque passe chronomètre un lot d'opérations
+// préparées à l'avance ; la remise en état du carnet se fait hors chrono.
+// Usage : OrderBookBench [--me_counters] [--benchmark_filter=Cancel] [options Google Benchmark]
+//   --me_counters : compteurs matériels par opération (voir PerfCounters), autour des
+//                   seules zones chronométrées
+// Rapport JSON pour benchcmp : --benchmark_out=F --benchmark_out_format=json
+// --benchmark_repetitions=R (révision git et modèle de CPU ajoutés au contexte)
+
+namespace {
+
+using namespace me;
+
+constexpr Ticks    kMid      = 100000;   // 1000.00 au pas de 0.01
+constexpr uint64_t kQuantity = 10;
+constexpr size_t   kBatch    = 64;       // opérations par passe chronométrée
+
+PerfCounters* g_counters = nullptr;     // --me_counters
+
+// Exécute `op` chronométré : le minuteur est en pause avant et après
+template<typename F>
+void timed(benchmark::State& state, F&& op) {
+    if (g_counters) g_counters->start();
+    state.ResumeTiming();
+    op();
+    state.PauseTiming();
+    if (g_counters) g_counters->stop();
+}
+
+// Carnet peuplé : `depth` niveaux d'achat sous le mid et de vente au-dessus,
+// `perLevel` ordres de kQuantity chacun. Les files d'ids sont tenues en miroir
+// (index 0 = meilleur niveau, ordre FIFO) pour viser une position précise.
+template<typename Book>
+class Fixture {
+public:
+    Fixture(size_t depth, size_t perLevel)
+      : book_(InstrumentSpec{ 0.01, 1.0, 2000.0 }), depth_(depth), perLevel_(perLevel),
+        bids_(depth), asks_(depth)
+    {
+        book_.reserve(2 * depth * perLevel + 4 * kBatch);
+        for (size_t l = 0; l < depth; ++l)
+            for (size_t k = 0; k < perLevel; ++k) {
+                addBid(l);
+                addAsk(l);
+            }
+    }
+
+    static Ticks bidTicks(size_t level) { return kMid - 1 - static_cast<Ticks>(level); }
+    static Ticks askTicks(size_t level) { return kMid + 1 + static_cast<Ticks>(level); }
+
+    Order limit(Side side, Ticks px, uint64_t qty, Action a = Action::NEW) {
+        return Order::makeLimit(0, nextId_++, symbol_, side, qty, scale_.toPrice(px), a);
+    }
+    Order cancel(uint64_t id) {
+        return Order::makeLimit(0, id, symbol_, Side::BUY, 0, 0.0, Action::CANCEL);
+    }
+    Order market(Side side, uint64_t qty) {
+        return Order::makeMarket(0, nextId_++, symbol_, side, qty, Action::NEW);
+    }
+
+    void addBid(size_t level) {
+        Order o = limit(Side::BUY, bidTicks(level), kQuantity);
+        bids_[level].push_back(o.order_id);
+        run(o);
+    }
+    void addAsk(size_t level) {
+        Order o = limit(Side::SELL, askTicks(level), kQuantity);
+        asks_[level].push_back(o.order_id);
+        run(o);
+    }
+
+    void run(const Order& o) { book_.process(o, [&](const Execution&) { ++fills_; }); }
+    void run(const std::vector<Order>& batch) {
+        for (auto const& o : batch) run(o);
+    }
+
+    // Retire du miroir les `n` ordres d'achat qu'un vendeur agressif consomme (meilleur
+    // niveau d'abord, FIFO) ; renvoie le niveau de chacun pour les remettre ensuite
+    std::vector<size_t> consumeBids(size_t n) {
+        std::vector<size_t> levels;
+        for (size_t l = 0; l < depth_ && levels.size() < n; ++l)
+            while (!bids_[l].empty() && levels.size() < n) {
+                bids_[l].pop_front();
+                levels.push_back(l);
+            }
+        return levels;
+    }
+    void refillBids(const std::vector<size_t>& levels) {
+        for (size_t l : levels) addBid(l);
+    }
+
+    Book&                             book()  { return book_; }
+    std::vector<std::deque<uint64_t>>& bids() { return bids_; }
+    size_t   depth()    const { return depth_; }
+    size_t   perLevel() const { return perLevel_; }
+
+private:
+    Book      book_;
+    TickScale scale_{ 0.01 };
+    Symbol    symbol_{ "BENCH" };
+    size_t    depth_, perLevel_;
+    std::vector<std::deque<uint64_t>> bids_, asks_;
+    uint64_t  nextId_ = 1;
+    uint64_t  fills_  = 0;
+};
+
+// Débit en opérations / s (« items_per_second »), temps par opération et,
+// avec --me_counters, compteurs matériels par opération
+void setCounters(benchmark::State& state, size_t opsPerPass) {
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * opsPerPass));
+    state.counters["op"] = benchmark::Counter(static_cast<double>(opsPerPass),
+        benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+    if (!g_counters) return;
+    double ops = static_cast<double>(state.iterations() * opsPerPass);
+    for (int e = 0; e < PerfCounters::kEvents; ++e) {
+        auto ev = static_cast<PerfCounters::Event>(e);
+        if (g_counters->available(ev) && ops > 0)
+            state.counters[PerfCounters::name(ev)] = g_counters->value(ev) / ops;
+    }
+    g_counters->reset();
+}
+
+// NEW sur un prix sans ordre : ouverture d'un niveau, au-delà du dernier niveau d'achat
+template<typename Book>
+void AddToEmptyLevel(benchmark::State& state) {
+    Fixture<Book> f(state.range(0), state.range(1));
+    std::vector<Order> adds, cancels;
+    for (auto _ : state) {
+        state.PauseTiming();
+        adds.clear();
+        cancels.clear();
+        for (size_t k = 0; k < kBatch; ++k) {
+            adds.push_back(f.limit(Side::BUY, Fixture<Book>::bidTicks(f.depth() + 1 + k), kQuantity));
+            cancels.push_back(f.cancel(adds.back().order_id));
+        }
+        timed(state, [&] { f.run(adds); });
+        f.run(cancels);
+        state.ResumeTiming();
+    }
+    setCounters(state, kBatch);
+}
+
+// NEW au meilleur prix d'achat, en queue d'une file déjà peuplée
+template<typename Book>
+void AddToExistingLevel(benchmark::State& state) {
+    Fixture<Book> f(state.range(0), state.range(1));
+    std::vector<Order> adds, cancels;
+    for (auto _ : state) {
+        state.PauseTiming();
+        adds.clear();
+        cancels.clear();
+        for (size_t k = 0; k < kBatch; ++k) {
+            adds.push_back(f.limit(Side::BUY, Fixture<Book>::bidTicks(k % f.depth()), kQuantity));
+            cancels.push_back(f.cancel(adds.back().order_id));
+        }
+        timed(state, [&] { f.run(adds); });
+        f.run(cancels);
+        state.ResumeTiming();
+    }
+    setCounters(state, kBatch);
+}
+
+// CANCEL d'un ordre en tête, au milieu ou en queue de sa file ; les niveaux sont
+// visités tour à tour et chaque ordre annulé est remplacé en queue hors chrono
+enum class Position { Head, Middle, Tail };
+
+template<typename Book, Position Where>
+void Cancel(benchmark::State& state) {
+    Fixture<Book> f(state.range(0), state.range(1));
+    size_t batch = std::min(kBatch, f.depth());
+    std::vector<Order>  cancels;
+    std::vector<size_t> levels;
+    size_t next = 0;
+    auto prepare = [&] {
+        cancels.clear();
+        levels.clear();
+        for (size_t k = 0; k < batch; ++k) {
+            size_t l   = next++ % f.depth();
+            auto&  ids = f.bids()[l];
+            size_t pos = Where == Position::Head ? 0 : Where == Position::Tail ? ids.size() - 1 : ids.size() / 2;
+            cancels.push_back(f.cancel(ids[pos]));
+            ids.erase(ids.begin() + static_cast<std::ptrdiff_t>(pos));
+            levels.push_back(l);
+        }
+    };
+    for (auto _ : state) {
+        state.PauseTiming();
+        prepare();
+        timed(state, [&] { f.run(cancels); });
+        for (size_t l : levels) f.addBid(l);
+        state.ResumeTiming();
+    }
+    setCounters(state, batch);
+}
+
+// SELL limit qui exécute exactement l'ordre en tête du meilleur niveau d'achat
+template<typename Book>
+void SingleFill(benchmark::State& state) {
+    Fixture<Book> f(state.range(0), state.range(1));
+    size_t batch = std::min(kBatch, f.depth() * f.perLevel());
+    std::vector<Order> hits;
+    for (auto _ : state) {
+        state.PauseTiming();
+        hits.clear();
+        for (size_t k = 0; k < batch; ++k)
+            hits.push_back(f.limit(Side::SELL, Fixture<Book>::bidTicks(f.depth() - 1), kQuantity));
+        auto consumed = f.consumeBids(batch);
+        timed(state, [&] { f.run(hits); });
+        f.refillBids(consumed);
+        state.ResumeTiming();
+    }
+    setCounters(state, batch);
+}
+
+// SELL limit qui balaie les (au plus) 4 meilleurs niveaux d'achat en entier
+template<typename Book>
+void SweepLevels(benchmark::State& state) {
+    Fixture<Book> f(state.range(0), state.range(1));
+    size_t levels = std::min<size_t>(4, f.depth());
+    size_t orders = levels * f.perLevel();
+    for (auto _ : state) {
+        state.PauseTiming();
+        Order sweep   = f.limit(Side::SELL, Fixture<Book>::bidTicks(levels - 1), orders * kQuantity);
+        auto consumed = f.consumeBids(orders);
+        timed(state, [&] { f.run(sweep); });
+        f.refillBids(consumed);
+        state.ResumeTiming();
+    }
+    setCounters(state, 1);
+    state.counters["fills/op"] = static_cast<double>(orders);
+}
+
+// MARKET qui parcourt tout le côté achat, niveau par niveau
+template<typename Book>
+void MarketWalk(benchmark::State& state) {
+    Fixture<Book> f(state.range(0), state.range(1));
+    size_t orders = f.depth() * f.perLevel();
+    for (auto _ : state) {
+        state.PauseTiming();
+        Order walk    = f.market(Side::SELL, orders * kQuantity);
+        auto consumed = f.consumeBids(orders);
+        timed(state, [&] { f.run(walk); });
+        f.refillBids(consumed);
+        state.ResumeTiming();
+    }
+    setCounters(state, 1);
+    state.counters["fills/op"] = static_cast<double>(orders);
+}
+
+// profondeur × ordres par niveau
+void bookShapes(benchmark::internal::Benchmark* b) {
+    b->ArgNames({ "depth", "perLevel" });
+    b->ArgsProduct({ { 1, 10, 100, 1000 }, { 1, 8, 64 } });
+}
+
+#define ME_BOOK_BENCH(name, ...)                                                          \
+    BENCHMARK_TEMPLATE(name, OrderBook, ##__VA_ARGS__)->Apply(bookShapes);                \
+    BENCHMARK_TEMPLATE(name, LadderOrderBook, ##__VA_ARGS__)->Apply(bookShapes)
+
+ME_BOOK_BENCH(AddToEmptyLevel);
+ME_BOOK_BENCH(AddToExistingLevel);
+ME_BOOK_BENCH(Cancel, Position::Head);
+ME_BOOK_BENCH(Cancel, Position::Middle);
+ME_BOOK_BENCH(Cancel, Position::Tail);
+ME_BOOK_BENCH(SingleFill);
+ME_BOOK_BENCH(SweepLevels);
+ME_BOOK_BENCH(MarketWalk);
+
+} // namespace
+
+int main(int argc, char** argv) {
+    setLoggingEnabled(false);
+
+    // --me_counters est retiré avant de passer la main à Google Benchmark
+    PerfCounters counters;
+    int kept = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--me_counters") g_counters = &counters;
+        else                                         argv[kept++] = argv[i];
+    }
+    argc = kept;
+    if (g_counters && !counters.available())
+        std::cerr << "Compteurs matériels indisponibles : " << counters.unavailableReason() << "\n";
+    counters.reset();
+
+    benchmark::AddCustomContext("git_revision", BenchReport::currentGitRevision());
+    benchmark::AddCustomContext("cpu_model", BenchReport::currentCpuModel());
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
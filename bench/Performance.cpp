@@ -1,50 +1,285 @@
 #include <iostream>
+#include <algorithm>
 #include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
 #include <random>
+#include <sstream>
+#include <string>
+#include "CsvParser.h"
+#include "CsvWriter.h"
 #include "MatchingEngine.h"
+#include "OrderFlowGenerator.h"
 #include "Order.h"
 #include "Logger.h"
+#include "PerfCounters.h"
+#include "BenchReport.h"
 
-int main() {
-    // ← ici on désactive tous les LOG_INFO / LOG_WARN / LOG_ERROR
-    me::setLoggingEnabled(false);
+// Usage : Performance [--flow] [--repeat R] [--json F]
+//         Performance --replay F [--output F] [--repeat R] [--json F]
+//   --flow     : flux réaliste (OrderFlowGenerator : Zipf, marche aléatoire, MODIFY / CANCEL /
+//                MARKET) au lieu de NEW LIMIT à prix uniformes
+//   --replay F : rejoue un fichier au format de data/input.csv, préchargé en mémoire, en
+//                chronométrant séparément parsing, matching et écriture (meilleur de R passes,
+//                3 par défaut) ; les résultats vont dans --output (fichier temporaire sinon)
+//   --repeat R : nombre de passes (1 par défaut en synthétique, 3 en rejeu)
+//   --json F   : rapport JSON (une valeur par passe et par métrique), à comparer avec benchcmp
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double since(Clock::time_point t0) {
+    return std::chrono::duration<double>(Clock::now() - t0).count();
+}
 
+// Bench historique : 500 000 ordres générés, seul process() est chronométré.
+// Chaque passe repart d'un moteur neuf, rejoue le warm-up puis mesure
+int runSynthetic(bool realistic, size_t repeat, me::BenchReport* report) {
     constexpr size_t N = 500000;
-    me::MatchingEngine eng;
 
     // 1) Génération hors chrono
     std::mt19937_64 rng{42};
     std::uniform_int_distribution<uint64_t> qty{1,100};
     std::uniform_real_distribution<double> price{10.0,500.0};
 
-    std::vector<me::Order> orders;
+    // Consommateur minimal : compte les résultats, sans rien allouer
+    size_t results = 0;
+    auto sink = [&](const me::MatchResult&) { ++results; };
+
+    std::vector<me::Order> warmup, orders;
     orders.reserve(N);
-    for (size_t i = 0; i < N; ++i) {
-        orders.emplace_back(
-          me::Order::makeLimit(
-            i, i,
-            "SYM" + std::to_string(i % 10),
-            (i%2 ? me::Side::BUY : me::Side::SELL),
-            qty(rng), price(rng),
-            me::Action::NEW
-          )
-        );
+    me::OrderFlowGenerator gen;
+    if (realistic) {
+        // Warm-up sur le début du flux ; un moteur fantôme, dans l'état du moteur
+        // mesuré, tient à jour les ordres vivants du générateur
+        me::MatchingEngine shadow;
+        gen.registerInstruments(shadow);
+        auto observe = [&](const me::MatchResult& r) { gen.observe(r); };
+        warmup.reserve(N);
+        for (size_t i = 0; i < N; ++i) {
+            warmup.push_back(gen.next());
+            shadow.process(warmup.back(), observe);
+        }
+        for (size_t i = 0; i < N; ++i) {
+            orders.push_back(gen.next());
+            shadow.process(orders.back(), observe);
+        }
+    }
+    else {
+        for (size_t i = 0; i < N; ++i) {
+            orders.emplace_back(
+              me::Order::makeLimit(
+                i, i,
+                "SYM" + std::to_string(i % 10),
+                (i%2 ? me::Side::BUY : me::Side::SELL),
+                qty(rng), price(rng),
+                me::Action::NEW
+              )
+            );
+        }
     }
 
-    // 2) Warm-up (pour peupler les carnets)
-    for (auto const&  o : orders) {
-        eng.process(o);
+    for (size_t pass = 0; pass < repeat; ++pass) {
+        me::MatchingEngine eng;
+        if (realistic) gen.registerInstruments(eng);
+
+        // 2) Warm-up (pour peupler les carnets)
+        for (auto const& o : realistic ? warmup : orders) {
+            eng.process(o, sink);
+        }
+
+        // 3) Mesure pure matching (compteurs matériels autour de la même boucle)
+        me::PerfCounters counters;
+        counters.start();
+        auto t0 = std::chrono::high_resolution_clock::now();
+        for (auto const& o : orders) {
+            eng.process(o, sink);
+        }
+        auto t1 = std::chrono::high_resolution_clock::now();
+        counters.stop();
+        double secs = std::chrono::duration<double>(t1 - t0).count();
+
+        std::cout << "Processed " << N << " orders in "
+                  << secs << " s → " << (N/secs) << " ops/s\n";
+        if (pass + 1 == repeat)
+            counters.print(std::cout, N, "ordre");
+        if (report) {
+            report->add("match.throughput", "ordres/s", true, N / secs);
+            report->add("match.ns_per_order", "ns", false, secs * 1e9 / N);
+            report->addCounters("match", counters, N, "ordre");
+        }
     }
+    return 0;
+}
+
+struct Phase {
+    explicit Phase(const char* n) : name(n) {}
+
+    const char*      name;
+    double           seconds = 0.0;   // meilleure passe
+    uint64_t         bytes   = 0;
+    me::PerfCounters counters;        // cumulés sur toutes les passes
+};
 
-    // 3) Mesure pure matching
-    auto t0 = std::chrono::high_resolution_clock::now();
-    for (auto const& o : orders) {
-        eng.process(o);
+void printPhase(const Phase& p, uint64_t orders, uint64_t fills) {
+    double s = p.seconds > 0.0 ? p.seconds : 1e-12;
+    std::cout << std::setfill(' ') << std::left << std::setw(7) << p.name << std::right
+              << std::fixed << std::setprecision(4) << std::setw(9) << p.seconds << " s"
+              << std::setprecision(1)
+              << std::setw(10) << p.bytes / s / (1 << 20) << " Mo/s"
+              << std::setprecision(0)
+              << std::setw(13) << orders / s << " ordres/s"
+              << std::setw(13) << fills / s << " fills/s\n";
+}
+
+// Rejeu d'un CSV d'ordres : le fichier est lu une fois en mémoire, puis chaque passe
+// mesure le parsing (depuis la mémoire), le matching (ordres déjà parsés, résultats
+// stockés) et l'écriture CSV (résultats déjà produits) indépendamment
+int runReplay(const std::string& input, std::string output, size_t repeat, me::BenchReport* report) {
+    std::string text;
+    {
+        std::ifstream in(input, std::ios::binary);
+        if (!in)
+            throw std::runtime_error("Impossible d'ouvrir « " + input + " »");
+        std::ostringstream buf;
+        buf << in.rdbuf();
+        text = std::move(buf).str();
     }
-    auto t1 = std::chrono::high_resolution_clock::now();
-    double secs = std::chrono::duration<double>(t1 - t0).count();
+    // en-tête sauté, comme le fait CsvParser
+    std::string_view body = text;
+    size_t           eol  = body.find('\n');
+    body.remove_prefix(eol == std::string_view::npos ? body.size() : eol + 1);
+
+    bool tempOutput = output.empty();
+    if (tempOutput)
+        output = (std::filesystem::temp_directory_path() / "me_replay_output.csv").string();
+
+    Phase parse{ "parse" }, match{ "match" }, write{ "write" };
+    parse.seconds = match.seconds = write.seconds = 1e300;
+    uint64_t orders = 0, results = 0, fills = 0, errors = 0;
+
+    std::vector<me::Order>       parsed;
+    std::vector<me::MatchResult> out;
+    for (size_t pass = 0; pass < repeat; ++pass) {
+        parsed.clear();
+        out.clear();
 
-    std::cout << "Processed " << N << " orders in "
-              << secs << " s → " << (N/secs) << " ops/s\n";
+        std::vector<me::ParseError> errs;
+        parse.counters.start();
+        auto t0 = Clock::now();
+        me::CsvParser::parseChunk(body, parsed, errs);
+        double parseSecs = since(t0);
+        parse.seconds = std::min(parse.seconds, parseSecs);
+        parse.counters.stop();
+
+        me::MatchingEngine engine;
+        out.reserve(parsed.size() * 2);
+        fills = 0;
+        match.counters.start();
+        t0 = Clock::now();
+        for (auto const& o : parsed)
+            engine.process(o, [&](const me::MatchResult& r) {
+                out.push_back(r);
+                fills += r.executed_quantity > 0;
+            });
+        double matchSecs = since(t0);
+        match.seconds = std::min(match.seconds, matchSecs);
+        match.counters.stop();
+
+        write.counters.start();
+        t0 = Clock::now();
+        {
+            me::CsvWriter writer(output);
+            for (auto const& r : out)
+                writer.write(r);
+            writer.close();
+        }
+        double writeSecs = since(t0);
+        write.seconds = std::min(write.seconds, writeSecs);
+        write.counters.stop();
+
+        orders  = parsed.size();
+        results = out.size();
+        errors  = errs.size();
+        if (report) {
+            // chaque passe est un échantillon ; le tableau affiché garde la meilleure
+            double n = static_cast<double>(std::max<uint64_t>(orders, 1));
+            report->add("parse.throughput", "Mo/s", true, body.size() / parseSecs / (1 << 20));
+            report->add("parse.ns_per_order", "ns", false, parseSecs * 1e9 / n);
+            report->add("match.throughput", "ordres/s", true, n / matchSecs);
+            report->add("match.ns_per_order", "ns", false, matchSecs * 1e9 / n);
+            report->add("match.fills_per_s", "fills/s", true, fills / matchSecs);
+            report->add("write.ns_per_result", "ns", false, writeSecs * 1e9 / std::max<double>(static_cast<double>(results), 1.0));
+        }
+    }
+
+    parse.bytes = match.bytes = body.size();
+    write.bytes = std::filesystem::file_size(output);
+    if (tempOutput)
+        std::remove(output.c_str());
+
+    std::cout << "Rejeu de " << input << " : " << orders << " ordres (" << errors << " lignes rejetées), "
+              << results << " résultats dont " << fills << " fills, meilleur de " << repeat << " passes\n";
+    for (auto const* p : { &parse, &match, &write })
+        printPhase(*p, orders, fills);
+    std::cout << "(Mo/s : octets d'entrée pour parse et match, octets écrits pour write)\n";
+    if (report) {
+        report->add("write.throughput", "Mo/s", true, write.bytes / write.seconds / (1 << 20));
+        for (auto const* p : { &parse, &match, &write })
+            report->addCounters(p->name, p->counters, static_cast<double>(orders * repeat), "ordre");
+    }
+    if (!match.counters.available()) {
+        match.counters.print(std::cout, 1.0, "ordre");
+        return 0;
+    }
+    for (auto const* p : { &parse, &match, &write }) {
+        std::cout << "\n[" << p->name << "] ";
+        p->counters.print(std::cout, static_cast<double>(orders * repeat), "ordre");
+    }
     return 0;
 }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    // ← ici on désactive tous les LOG_INFO / LOG_WARN / LOG_ERROR
+    me::setLoggingEnabled(false);
+
+    try {
+        bool        realistic = false;
+        std::string replay, output, json;
+        size_t      repeat = 0;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--flow")                          realistic = true;
+            else if (arg == "--replay" && i + 1 < argc)   replay = argv[++i];
+            else if (arg == "--output" && i + 1 < argc)   output = argv[++i];
+            else if (arg == "--repeat" && i + 1 < argc)   repeat = std::max<size_t>(1, std::stoul(argv[++i]));
+            else if (arg == "--json" && i + 1 < argc)     json = argv[++i];
+            else
+                throw std::runtime_error("Argument inconnu : " + arg);
+        }
+        if (repeat == 0)
+            repeat = replay.empty() ? 1 : 3;
+
+        me::BenchReport report(replay.empty() ? "Performance" : "Performance --replay");
+        report.setParam("mode", !replay.empty() ? "replay" : realistic ? "flow" : "uniform");
+        if (!replay.empty()) report.setParam("input", replay);
+        report.setParam("repeat", std::to_string(repeat));
+
+        me::BenchReport* r = json.empty() ? nullptr : &report;
+        int rc = replay.empty() ? runSynthetic(realistic, repeat, r) : runReplay(replay, output, repeat, r);
+        if (r) {
+            report.writeFile(json);
+            std::cout << "Rapport JSON : " << json << "\n";
+        }
+        return rc;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Erreur fatale : " << e.what() << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace me {
+
+    // Comptage des allocations du thread courant. Les compteurs ne bougent que
+    // dans les exécutables liés à la bibliothèque objet `alloc_hooks`, qui
+    // remplace operator new / delete (bench Allocations, test_Allocations) ;
+    // ailleurs hooksInstalled() est faux et les compteurs restent à zéro.
+    namespace alloc {
+
+        struct Counts {
+            uint64_t allocations   = 0;
+            uint64_t deallocations = 0;
+            uint64_t bytes         = 0;   // octets demandés aux allocations
+
+            Counts operator-(const Counts& o) const {
+                return { allocations - o.allocations, deallocations - o.deallocations, bytes - o.bytes };
+            }
+        };
+
+        // Compteurs cumulés du thread courant
+        Counts current();
+        bool   hooksInstalled();
+
+        // Allocations du thread courant depuis la construction
+        class Scope {
+        public:
+            Scope() : start_(current()) {}
+            [[nodiscard]] Counts delta() const { return current() - start_; }
+        private:
+            Counts start_;
+        };
+
+        // Appelés par les hooks ; sans allocation ni verrou
+        void recordAllocation(size_t bytes);
+        void recordDeallocation();
+        void markHooksInstalled();
+
+    } // namespace alloc
+
+} // namespace me
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace me {
+
+    class LatencyHistogram;
+    class PerfCounters;
+
+    // Résultats d'un bench au format JSON, pour archivage et comparaison (benchcmp) :
+    //   { "benchmark": "...", "git_revision": "...", "cpu_model": "...", "date": "...",
+    //     "build_type": "...", "params": { "clé": "valeur", ... },
+    //     "metrics": [ { "name": "...", "unit": "...", "better": "higher" | "lower",
+    //                    "samples": [ une valeur par passe ] }, ... ] }
+    // Chaque passe répétée ajoute un échantillon à ses métriques : la comparaison
+    // s'appuie sur leur dispersion, pas sur un chiffre isolé.
+    class BenchReport {
+    public:
+        struct Metric {
+            std::string         name;
+            std::string         unit;
+            bool                higherIsBetter = true;
+            std::vector<double> samples;
+        };
+
+        explicit BenchReport(std::string benchmark = {});
+
+        // Ajoute un échantillon à la métrique `name` (créée au premier appel)
+        void add(const std::string& name, const std::string& unit, bool higherIsBetter, double value);
+        // p50 / p99 / p99.9 / p99.99 / max / mean, en ns, sous « prefix.p50 »…
+        void addLatency(const std::string& prefix, const LatencyHistogram& h);
+        // Compteurs disponibles divisés par `units`, sous « prefix.cycles »…
+        void addCounters(const std::string& prefix, const PerfCounters& c, double units, const std::string& unit);
+        void setParam(const std::string& key, const std::string& value);
+
+        [[nodiscard]] const std::string&         benchmark()   const { return benchmark_; }
+        [[nodiscard]] const std::string&         gitRevision() const { return gitRevision_; }
+        [[nodiscard]] const std::string&         cpuModel()    const { return cpuModel_; }
+        [[nodiscard]] const std::vector<Metric>& metrics()     const { return metrics_; }
+        [[nodiscard]] const Metric*              find(const std::string& name) const;
+
+        void write(std::ostream& os) const;
+        // Écrit le fichier ; lève std::runtime_error en cas d'échec
+        void writeFile(const std::string& path) const;
+
+        // Relit un rapport BenchReport, ou la sortie JSON de Google Benchmark
+        // (--benchmark_out_format=json, passes répétées regroupées par nom)
+        static BenchReport readFile(const std::string& path);
+        static BenchReport parse(const std::string& json);
+
+        // Révision git du source au moment de la configuration CMake, modèle de CPU
+        static std::string currentGitRevision();
+        static std::string currentCpuModel();
+
+    private:
+        std::string                                      benchmark_;
+        std::string                                      gitRevision_;
+        std::string                                      cpuModel_;
+        std::string                                      date_;
+        std::string                                      buildType_;
+        std::vector<std::pair<std::string, std::string>> params_;
+        std::vector<Metric>                              metrics_;
+    };
+
+    // Comparaison d'une métrique entre une référence et un candidat : test de
+    // Welch sur les échantillons des passes répétées, intervalle de confiance
+    // à 95 % de la variation relative des moyennes
+    struct MetricComparison {
+        enum Verdict { Unchanged, Improvement, Regression, Inconclusive };
+
+        double  baseMean = 0, candMean = 0;
+        double  change   = 0;             // (candidat - référence) / |référence|, ±inf si référence nulle
+        double  ciLow    = 0, ciHigh = 0; // bornes de l'IC 95 % de `change`
+        Verdict verdict  = Inconclusive;
+    };
+
+    // Significatif si l'IC exclut 0 et si |change| dépasse `threshold` (0.02 = 2 %) ;
+    // variance nulle des deux côtés : comparaison exacte au seuil, sans IC ; référence
+    // nulle : tout écart est significatif (0 → 0,3 allocation = régression).
+    // Inconclusive sinon, s'il manque des passes (moins de 2 échantillons d'un côté)
+    MetricComparison compareMetric(const BenchReport::Metric& base,
+                                   const BenchReport::Metric& cand, double threshold);
+    const char* toString(MetricComparison::Verdict v);
+
+} // namespace me
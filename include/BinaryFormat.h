@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Order.h"
+#include "MatchResult.h"
+#include "InstrumentSpec.h"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace me {
+
+    // Format binaire à enregistrements de taille fixe, little-endian, pour les
+    // ordres (entrée) et les MatchResult (sortie) :
+    //
+    //   [en-tête 32 o][enregistrement × recordCount][dictionnaire des symboles]
+    //
+    // Les instruments sont des ids denses propres au fichier, les prix des ticks
+    // entiers (1e-8 : un prix CSV à 8 décimales au plus fait l'aller-retour exact),
+    // les enums un octet. Le dictionnaire (longueur u16 + octets, dans l'ordre des
+    // ids) suit les enregistrements, l'en-tête donne son offset : un writer en flux
+    // n'a pas besoin de connaître tous les instruments avant le premier ordre.
+    namespace binfmt {
+
+        constexpr char     kOrderMagic[4]  = { 'M', 'E', 'O', 'R' };
+        constexpr char     kResultMagic[4] = { 'M', 'E', 'R', 'S' };
+        constexpr uint16_t kVersion        = 1;
+        constexpr uint32_t kPriceDecimals  = 8;
+        constexpr double   kTickSize       = 1e-8;
+
+        constexpr size_t kHeaderSize       = 32;
+        constexpr size_t kOrderRecordSize  = 40;
+        constexpr size_t kResultRecordSize = 64;
+
+        struct Header {
+            char     magic[4];
+            uint16_t version;
+            uint16_t recordSize;
+            uint32_t symbolCount;
+            uint32_t priceDecimals;
+            uint64_t recordCount;
+            uint64_t dictOffset;     // début du dictionnaire des symboles
+        };
+
+        // --- accès little-endian, indépendants de l'alignement et de l'hôte ---
+        template<typename T>
+        inline void store(unsigned char* p, T v) {
+            for (size_t i = 0; i < sizeof(T); ++i)
+                p[i] = static_cast<unsigned char>(static_cast<uint64_t>(v) >> (8 * i));
+        }
+
+        template<typename T>
+        inline T load(const unsigned char* p) {
+            uint64_t v = 0;
+            for (size_t i = 0; i < sizeof(T); ++i)
+                v |= static_cast<uint64_t>(p[i]) << (8 * i);
+            return static_cast<T>(v);
+        }
+
+        void   encodeHeader(unsigned char* p, const Header& h);
+        Header decodeHeader(const unsigned char* p);
+
+        // Ordre : ts, id, prix (ticks), quantité, symbole (u32), side, type, action, 1 octet libre
+        void encodeOrder(unsigned char* p, const Order& o, uint32_t symbol, const TickScale& scale);
+        // MatchResult : ts, id, quantité, prix, exec_qty, exec_prix, contrepartie,
+        // symbole (u32), side, type, action, status
+        void encodeResult(unsigned char* p, const MatchResult& r, uint32_t symbol, const TickScale& scale);
+
+        // Décodage ; `symbols` traduit l'id du fichier en Symbol interné.
+        // Lève std::runtime_error sur un id de symbole ou un octet d'enum hors domaine.
+        Order       decodeOrder (const unsigned char* p, const std::vector<Symbol>& symbols, const TickScale& scale);
+        MatchResult decodeResult(const unsigned char* p, const std::vector<Symbol>& symbols, const TickScale& scale);
+
+    } // namespace binfmt
+
+} // namespace me
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "BinaryFormat.h"
+#include "MappedFile.h"
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace me {
+
+    // Lecture d'un fichier binaire projeté en mémoire (voir BinaryFormat.h).
+    // L'en-tête et le dictionnaire sont validés à l'ouverture (std::runtime_error
+    // sinon) ; les symboles du fichier sont internés une seule fois.
+    class BinaryReader {
+    public:
+        [[nodiscard]] size_t size() const { return static_cast<size_t>(header_.recordCount); }
+        [[nodiscard]] const std::vector<Symbol>& symbols() const { return symbols_; }
+
+    protected:
+        BinaryReader(const std::string& filename, const char (&magic)[4], size_t recordSize);
+
+        [[nodiscard]] const unsigned char* record(size_t i) const {
+            return base_ + binfmt::kHeaderSize + i * header_.recordSize;
+        }
+
+        MappedFile           file_;
+        const unsigned char* base_ = nullptr;
+        binfmt::Header       header_{};
+        std::vector<Symbol>  symbols_;
+        TickScale            scale_;
+        size_t               pos_ = 0;    // prochain enregistrement de next()
+    };
+
+    // Ordres d'un fichier produit par csv2bin, consommables comme un CsvParser
+    class BinaryOrderReader : public BinaryReader {
+    public:
+        explicit BinaryOrderReader(const std::string& filename)
+          : BinaryReader(filename, binfmt::kOrderMagic, binfmt::kOrderRecordSize) {}
+
+        [[nodiscard]] Order at(size_t i) const { return binfmt::decodeOrder(record(i), symbols_, scale_); }
+
+        std::optional<Order> next() {
+            if (pos_ >= size()) return std::nullopt;
+            return at(pos_++);
+        }
+    };
+
+    class BinaryResultReader : public BinaryReader {
+    public:
+        explicit BinaryResultReader(const std::string& filename)
+          : BinaryReader(filename, binfmt::kResultMagic, binfmt::kResultRecordSize) {}
+
+        [[nodiscard]] MatchResult at(size_t i) const { return binfmt::decodeResult(record(i), symbols_, scale_); }
+
+        std::optional<MatchResult> next() {
+            if (pos_ >= size()) return std::nullopt;
+            return at(pos_++);
+        }
+    };
+
+    // Vrai si le fichier commence par l'en-tête d'un fichier d'ordres / de résultats binaire
+    bool isBinaryOrderFile(const std::string& filename);
+    bool isBinaryResultFile(const std::string& filename);
+
+} // namespace me
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "BinaryFormat.h"
+#include "OutputFile.h"
+#include <string>
+#include <vector>
+
+namespace me {
+
+    // Écriture d'un fichier binaire (voir BinaryFormat.h) : les enregistrements
+    // sont encodés directement dans le tampon d'un OutputFile (synchrone ou
+    // asynchrone) ; le dictionnaire des symboles et l'en-tête définitif sont
+    // écrits par close() (ou le destructeur).
+    class BinaryWriter {
+    public:
+        BinaryWriter(const BinaryWriter&)            = delete;
+        BinaryWriter& operator=(const BinaryWriter&) = delete;
+
+        // Termine le fichier ; sans effet au second appel
+        void close();
+
+        [[nodiscard]] uint64_t count() const { return count_; }
+        [[nodiscard]] const OutputFile& file() const { return out_; }
+
+    protected:
+        BinaryWriter(const std::string& filename, const char (&magic)[4], size_t recordSize,
+                     const OutputFile::Options& opts);
+        ~BinaryWriter();
+
+        // Emplacement du prochain enregistrement, réservé dans le tampon de sortie
+        unsigned char* append() {
+            char* p = out_.reserve(recordSize_);
+            out_.commit(p + recordSize_);
+            ++count_;
+            return reinterpret_cast<unsigned char*>(p);
+        }
+        // Id du symbole dans ce fichier, attribué à la première rencontre
+        uint32_t fileId(Symbol s);
+
+        TickScale scale_{ binfmt::kTickSize };
+
+    private:
+        OutputFile                 out_;
+        char                       magic_[4];
+        size_t                     recordSize_;
+        uint64_t                   count_  = 0;
+        std::vector<uint32_t>      fileIds_;    // id global → id fichier (+1, 0 = absent)
+        std::vector<Symbol>        symbols_;    // id fichier → symbole
+        bool                       closed_ = false;
+    };
+
+    class BinaryOrderWriter : public BinaryWriter {
+    public:
+        explicit BinaryOrderWriter(const std::string& filename, const OutputFile::Options& opts = {})
+          : BinaryWriter(filename, binfmt::kOrderMagic, binfmt::kOrderRecordSize, opts) {}
+
+        void write(const Order& o) {
+            uint32_t id = fileId(o.instrument);
+            binfmt::encodeOrder(append(), o, id, scale_);
+        }
+    };
+
+    class BinaryResultWriter : public BinaryWriter {
+    public:
+        explicit BinaryResultWriter(const std::string& filename, const OutputFile::Options& opts = {})
+          : BinaryWriter(filename, binfmt::kResultMagic, binfmt::kResultRecordSize, opts) {}
+
+        // Utilisable directement comme ResultSink
+        void write(const MatchResult& r) {
+            uint32_t id = fileId(r.instrument);
+            binfmt::encodeResult(append(), r, id, scale_);
+        }
+    };
+
+} // namespace me
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Order.h"
+#include "MatchResult.h"
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace me::csv {
+
+    // Formatage sans locale ni allocation, directement dans le tampon de sortie.
+    // Chaque fonction écrit à partir de `p` et renvoie la fin de ce qu'elle a écrit.
+
+    constexpr size_t kMaxNumber = 32;   // place suffisante pour un entier ou un prix
+
+    inline char* put(char* p, std::string_view s) {
+        std::memcpy(p, s.data(), s.size());
+        return p + s.size();
+    }
+
+    inline char* put(char* p, uint64_t v) {
+        return std::to_chars(p, p + kMaxNumber, v).ptr;
+    }
+
+    // Prix en virgule fixe à 8 décimales (le tick le plus fin), zéros de fin retirés :
+    // 150.25 → "150.25", 250 → "250", 0 → "0". Au-delà de 1e15, forme la plus courte.
+    inline char* putPrice(char* p, double v) {
+        if (!(std::abs(v) < 1e15))
+            return std::to_chars(p, p + kMaxNumber, v).ptr;
+        char* end = std::to_chars(p, p + kMaxNumber, v, std::chars_format::fixed, 8).ptr;
+        while (end[-1] == '0') --end;
+        if (end[-1] == '.')    --end;
+        return end;
+    }
+
+    // Tables constantes des libellés d'enums
+    constexpr std::string_view kSideNames[]   = { "BUY", "SELL" };
+    constexpr std::string_view kTypeNames[]   = { "LIMIT", "MARKET" };
+    constexpr std::string_view kActionNames[] = { "NEW", "MODIFY", "CANCEL" };
+    constexpr std::string_view kStatusNames[] = { "PENDING", "EXECUTED", "PARTIALLY_EXECUTED", "CANCELED", "REJECTED" };
+
+    inline std::string_view name(Side s)   { return kSideNames[static_cast<size_t>(s)]; }
+    inline std::string_view name(Type t)   { return kTypeNames[static_cast<size_t>(t)]; }
+    inline std::string_view name(Action a) { return kActionNames[static_cast<size_t>(a)]; }
+    inline std::string_view name(Status s) { return kStatusNames[static_cast<size_t>(s)]; }
+
+    // Taille maximale d'une ligne hors nom d'instrument
+    constexpr size_t kMaxRow = 12 * (kMaxNumber + 1) + 1;
+
+} // namespace me::csv
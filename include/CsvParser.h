@@ -1,7 +1,10 @@
 #pragma once
 
 #include "Order.h"
+#include "MappedFile.h"
+#include "CsvScanner.h"
 #include <string>
+#include <string_view>
 #include <vector>
 #include <fstream>
 #include <stdexcept>
@@ -15,19 +18,55 @@ namespace me {
         std::string raw_line;
     };
 
+    // Trace une erreur de parsing (niveau WARN)
+    void logParseError(ParseError const& e);
+
     class CsvParser {
     public:
-        explicit CsvParser(std::string const& filename);
+        // Mapped : fichier projeté en mémoire, lignes et champs lus en place (aucune copie),
+        //          séparateurs repérés en SIMD par CsvScanner
+        // Stream : lecture ligne à ligne par std::ifstream dans un tampon réutilisé
+        enum class Source { Mapped, Stream };
+
+        explicit CsvParser(std::string const& filename, Source source = Source::Mapped);
         std::optional<Order> next();
         std::vector<ParseError> const& getErrors() const { return errors_; }
 
+        // Analyse une ligne de données (sans '\n') ; en cas d'échec, l'erreur est
+        // ajoutée à `errors` avec `lineNumber` et std::nullopt est renvoyé
+        static std::optional<Order> parseLine(std::string_view line, size_t lineNumber,
+                                              std::vector<ParseError>& errors);
+
+        // Analyse un bloc de lignes complètes (sans en-tête) : ordres valides dans `orders`,
+        // erreurs dans `errors` numérotées à partir de 1 au début du bloc, sans log.
+        // Renvoie le nombre de lignes du bloc. Sans état : appelable depuis plusieurs threads.
+        static size_t parseChunk(std::string_view text, std::vector<Order>& orders,
+                                 std::vector<ParseError>& errors);
+
+        static constexpr size_t kColumns = 8;
+        using Fields = std::string_view[kColumns + 1];
+
     private:
-        std::ifstream            in_;          // le flux
+        // Ligne suivante, vue valide jusqu'au prochain appel ; false en fin de fichier.
+        // En mode Mapped, les champs sont découpés au passage (`fields`, `count`).
+        bool readLine(std::string_view& line, Fields& fields, size_t& count);
+
+        // Ligne suivante de `text` à partir de `pos`, découpée en champs au fil du scanner
+        static bool scanLine(std::string_view text, CsvScanner& scanner, size_t& pos,
+                             std::string_view& line, Fields& fields, size_t& count);
+
+        // Validation et construction de l'ordre à partir des champs déjà découpés
+        static std::optional<Order> parseFields(std::string_view line, Fields const& fields, size_t count,
+                                                size_t lineNumber, std::vector<ParseError>& errors);
+
+        Source                   source_;
+        MappedFile               file_;        // mode Mapped
+        CsvScanner               scanner_{ std::string_view{} };   // séparateurs de file_
+        size_t                   pos_ = 0;     // début de la prochaine ligne dans file_
+        std::ifstream            in_;          // mode Stream
+        std::string              buffer_;      // ligne courante en mode Stream
         size_t                   lineNumber_;  // index de la ligne courante
         std::vector<ParseError>  errors_;      // accumulateur d’erreurs
-
-        // helper pour découper la ligne en champs
-        static std::vector<std::string> split(std::string const& s, char delim);
     };
 
 } // namespace me
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "OccupancyBitmap.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace me {
+
+    // Repérage des séparateurs CSV (',' et '\n') par blocs de 64 octets :
+    // chaque bloc est comparé en vectoriel (SSE2 : 4 × 16 octets, AVX2 : 2 × 32)
+    // et les résultats sont réunis par movemask en un masque de 64 bits, dont
+    // on extrait ensuite les positions une à une (ctz) sans relire les octets.
+    // Le noyau est choisi à l'exécution selon le CPU ; repli scalaire partout ailleurs.
+    class CsvScanner {
+    public:
+        enum class Kernel { Scalar, Sse2, Avx2 };
+
+        static constexpr size_t kBlock = 64;
+
+        // Meilleur noyau supporté par le CPU courant (détecté une seule fois)
+        static Kernel bestKernel();
+        static bool   supported(Kernel k);
+        static const char* name(Kernel k);
+
+        // Masque des ',' et '\n' des 64 octets de `block` (bit i ↔ block[i])
+        static uint64_t delimiterMask(const char* block, Kernel k);
+
+        explicit CsvScanner(std::string_view text, Kernel k = bestKernel());
+
+        // Position du prochain ',' ou '\n' à partir de la position courante,
+        // ou text.size() s'il n'y en a plus
+        size_t next() {
+            while (mask_ == 0) {
+                block_ += kBlock;
+                if (block_ >= text_.size())
+                    return text_.size();
+                load();
+            }
+            size_t pos = block_ + static_cast<size_t>(lowestBit(mask_));
+            mask_ &= mask_ - 1;
+            return pos;
+        }
+
+        // Reprend le balayage à `pos`
+        void seek(size_t pos);
+
+        [[nodiscard]] Kernel kernel() const { return kernel_; }
+
+    private:
+        using MaskFn = uint64_t (*)(const char*);
+
+        static MaskFn select(Kernel k);
+        void load();   // masque du bloc courant (complété par des zéros en fin de texte)
+
+        std::string_view text_;
+        Kernel           kernel_;
+        MaskFn           fn_;
+        size_t           block_ = 0;   // début du bloc courant
+        uint64_t         mask_  = 0;   // séparateurs restants du bloc courant
+    };
+
+} // namespace me
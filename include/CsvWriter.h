@@ -2,22 +2,42 @@
 
 #include "Order.h"
 #include "MatchResult.h"
+#include "OutputFile.h"
 #include <vector>
-#include <fstream>
 #include <stdexcept>
 
 namespace me {
 
+    // Résultats au format de data/output.csv
     class CsvWriter {
     public:
-        explicit CsvWriter(const std::string& filename);
+        explicit CsvWriter(const std::string& filename, const OutputFile::Options& opts = {});
         // Écrit un ordre avec ses résultats d'exécution
         void writeOrder(const Order& o,
             const std::vector<MatchResult>& results);
+        // Écrit un seul résultat (utilisable directement comme ResultSink)
+        void write(const MatchResult& r);
+        // Transmet à l'OS les lignes encore en tampon (fait aussi à la destruction)
+        void flush() { out_.flush(); }
+        // Vide tout et ferme (synchronisé sur disque si opts.durable) ; erreurs levées ici
+        void close() { out_.close(); }
+        [[nodiscard]] const OutputFile& file() const { return out_; }
 
     private:
-        std::ofstream out_;
+        OutputFile out_;
         void writeHeader();
     };
 
+    // Ordres au format de data/input.csv
+    class CsvOrderWriter {
+    public:
+        explicit CsvOrderWriter(const std::string& filename, const OutputFile::Options& opts = {});
+        void write(const Order& o);
+        void flush() { out_.flush(); }
+        void close() { out_.close(); }
+
+    private:
+        OutputFile out_;
+    };
+
 } // namespace me
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <utility>
+
+namespace me {
+
+    // Table de hachage à adressage ouvert, clés uint64_t (order_id).
+    // Sondage linéaire dans un tableau contigu ; la suppression recule les
+    // entrées suivantes (backward shift) au lieu de laisser des pierres tombales,
+    // si bien que la table ne se dégrade pas au fil des insertions/suppressions.
+    // Aucune allocation tant que la capacité réservée n'est pas dépassée.
+    template<typename Value>
+    class FlatHashMap {
+    public:
+        explicit FlatHashMap(size_t capacity = 16) { rehash(capacity); }
+
+        [[nodiscard]] size_t size()  const { return size_; }
+        [[nodiscard]] bool   empty() const { return size_ == 0; }
+
+        Value* find(uint64_t key) {
+            for (size_t i = home(key); slots_[i].used; i = (i + 1) & mask_)
+                if (slots_[i].key == key) return &slots_[i].value;
+            return nullptr;
+        }
+        const Value* find(uint64_t key) const {
+            return const_cast<FlatHashMap*>(this)->find(key);
+        }
+
+        // Insère une valeur par défaut si la clé est absente
+        Value& operator[](uint64_t key) {
+            size_t i = home(key);
+            for (; slots_[i].used; i = (i + 1) & mask_)
+                if (slots_[i].key == key) return slots_[i].value;
+            if ((size_ + 1) * 4 > slots_.size() * 3) {   // charge max 75 %
+                rehash(slots_.size() * 2);
+                return (*this)[key];
+            }
+            slots_[i] = Slot{ key, Value{}, true };
+            ++size_;
+            return slots_[i].value;
+        }
+
+        bool erase(uint64_t key) {
+            size_t i = home(key);
+            for (; slots_[i].used; i = (i + 1) & mask_)
+                if (slots_[i].key == key) break;
+            if (!slots_[i].used) return false;
+
+            // backward shift : on remonte dans le trou chaque entrée dont la
+            // position idéale n'est pas située entre le trou et elle-même
+            for (size_t j = (i + 1) & mask_; slots_[j].used; j = (j + 1) & mask_) {
+                size_t h = home(slots_[j].key);
+                if (((j - h) & mask_) >= ((j - i) & mask_)) {
+                    slots_[i] = std::move(slots_[j]);
+                    i = j;
+                }
+            }
+            slots_[i].used = false;
+            --size_;
+            return true;
+        }
+
+        // Prépare la table pour n entrées sans réallocation
+        void reserve(size_t n) {
+            if (n * 4 > slots_.size() * 3)
+                rehash(n * 4 / 3 + 1);
+        }
+
+        void clear() {
+            for (auto& s : slots_) s.used = false;
+            size_ = 0;
+        }
+
+        // Parcours de toutes les entrées (ordre non spécifié)
+        template<typename F>
+        void forEach(F&& f) const {
+            for (auto const& s : slots_)
+                if (s.used) f(s.key, s.value);
+        }
+
+    private:
+        struct Slot {
+            uint64_t key   = 0;
+            Value    value = {};
+            bool     used  = false;
+        };
+
+        // Hachage de Fibonacci : disperse les identifiants séquentiels
+        [[nodiscard]] size_t home(uint64_t key) const {
+            return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> shift_);
+        }
+
+        void rehash(size_t capacity) {
+            size_t cap = 16;
+            unsigned bits = 4;
+            while (cap < capacity) { cap <<= 1; ++bits; }
+
+            std::vector<Slot> old;
+            old.swap(slots_);
+            slots_.assign(cap, Slot{});
+            mask_  = cap - 1;
+            shift_ = 64 - bits;
+            size_  = 0;
+            for (auto& s : old)
+                if (s.used) (*this)[s.key] = std::move(s.value);
+        }
+
+        std::vector<Slot> slots_;
+        size_t            mask_  = 0;
+        unsigned          shift_ = 0;
+        size_t            size_  = 0;
+    };
+
+} // namespace me
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace me {
+
+    template<typename Signature>
+    class FunctionRef;
+
+    // Référence non propriétaire vers un appelable (lambda, foncteur, fonction).
+    // Deux pointeurs, aucune allocation : sert à brancher un consommateur
+    // d'événements sur le chemin critique. L'appelable doit survivre à l'appel.
+    template<typename R, typename... Args>
+    class FunctionRef<R(Args...)> {
+    public:
+        template<typename F,
+                 typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, FunctionRef>>>
+        FunctionRef(F&& f) noexcept
+          : obj_(const_cast<void*>(static_cast<const void*>(std::addressof(f)))),
+            call_([](void* obj, Args... args) -> R {
+                return (*static_cast<std::add_pointer_t<std::remove_reference_t<F>>>(obj))(
+                    std::forward<Args>(args)...);
+            })
+        {}
+
+        R operator()(Args... args) const {
+            return call_(obj_, std::forward<Args>(args)...);
+        }
+
+    private:
+        void* obj_;
+        R   (*call_)(void*, Args...);
+    };
+
+} // namespace me
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+namespace me {
+
+    // Prix exprimé en nombre entier de ticks
+    using Ticks = int64_t;
+
+    // Référentiel d'un instrument : pas de cotation et bande de prix autorisée
+    struct InstrumentSpec {
+        double tick_size = 1e-8;   // pas de cotation (défaut : quasi sans perte pour les CSV)
+        double min_price = 0.0;    // borne basse de la bande
+        double max_price = 0.0;    // borne haute (0 = pas de bande)
+
+        [[nodiscard]] bool hasBand() const { return max_price > min_price; }
+    };
+
+    // Conversion prix ⇄ ticks pour un pas de cotation donné
+    class TickScale {
+    public:
+        explicit TickScale(double tickSize = InstrumentSpec{}.tick_size)
+          : tick_(tickSize), perUnit_(0.0)
+        {
+            // Pas du type 1/N (0.01, 0.05, 1e-8…) : on divise par N entier,
+            // ce qui redonne exactement le prix décimal d'origine
+            double inv = 1.0 / tickSize;
+            if (tickSize < 1.0 && std::abs(inv - std::round(inv)) < 1e-6 * inv)
+                perUnit_ = std::round(inv);
+        }
+
+        [[nodiscard]] Ticks toTicks(double price) const {
+            return perUnit_ > 0.0 ? std::llround(price * perUnit_)
+                                  : std::llround(price / tick_);
+        }
+
+        [[nodiscard]] double toPrice(Ticks t) const {
+            return perUnit_ > 0.0 ? static_cast<double>(t) / perUnit_
+                                  : static_cast<double>(t) * tick_;
+        }
+
+        // Vrai si le prix tombe sur un multiple du pas (à l'arrondi flottant près)
+        [[nodiscard]] bool onTick(double price) const {
+            double t = perUnit_ > 0.0 ? price * perUnit_ : price / tick_;
+            return std::abs(t - std::round(t)) < 1e-6;
+        }
+
+        [[nodiscard]] double tickSize() const { return tick_; }
+
+    private:
+        double tick_;
+        double perUnit_;   // ticks par unité de prix si le pas est 1/N, sinon 0
+    };
+
+} // namespace me
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "BinaryFormat.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace me {
+
+    // Journal d'écriture anticipée : chaque ordre entrant reçoit un numéro de
+    // séquence et est ajouté, avant d'être traité, à un journal binaire en ajout
+    // seul. Rejouer le journal dans un moteur neuf reconstruit exactement ses
+    // carnets (le matching est déterministe).
+    //
+    // Le journal est un répertoire de segments préalloués (segment-00000000.mej…)
+    // projetés en mémoire : un ajout est une simple copie de 64 octets dans la
+    // projection, sans appel système. Dès qu'append() rend la main, l'ordre survit
+    // à un crash du processus (la page est dans le cache de l'OS) ; la survie à
+    // une coupure de la machine dépend du niveau de durabilité, c'est-à-dire de la
+    // fréquence des msync.
+    //
+    // Format d'un segment (little-endian, enregistrements de 64 octets) :
+    //   [en-tête 64 o][enregistrement × n][zéros jusqu'à la taille préallouée]
+    //   enregistrement : type (1 o), 3 o libres, somme de contrôle (u32),
+    //                    séquence (ordre) ou id de symbole (u64), charge utile 48 o
+    //   - ordre   : encodage binfmt de l'ordre (40 o, symbole = id du segment)
+    //   - symbole : longueur (u16) + nom (46 o au plus), écrit à la première
+    //               rencontre dans le segment : chaque segment se relit seul
+    // Le premier enregistrement nul ou dont la somme ne correspond pas marque
+    // la fin du journal (écriture interrompue par une coupure).
+    class Journal {
+    public:
+        enum class Durability {
+            None,    // aucune synchronisation explicite : l'OS écrit quand il veut
+            Async,   // thread de fond : msync toutes les `intervalUs` µs
+            Group,   // group commit : msync par l'appelant toutes les `groupSize` écritures
+            Sync     // msync après chaque ordre (référence : le coût d'un fsync par ordre)
+        };
+
+        struct Options {
+            Durability durability   = Durability::Group;
+            size_t     segmentBytes = size_t{64} << 20;   // préalloué à la création
+            size_t     groupSize    = 256;                // Group : ordres par msync
+            uint64_t   intervalUs   = 1000;               // Async : période du msync de fond
+        };
+
+        static constexpr size_t kRecordSize = 64;
+
+        // Ouvre (ou crée) le journal du répertoire `dir` ; un journal existant est
+        // prolongé après son dernier enregistrement valide
+        explicit Journal(const std::string& dir) : Journal(dir, Options{}) {}
+        Journal(const std::string& dir, const Options& opts);
+        ~Journal();
+
+        Journal(const Journal&)            = delete;
+        Journal& operator=(const Journal&) = delete;
+
+        // Ajoute l'ordre au journal ; renvoie son numéro de séquence (1, 2, 3…)
+        uint64_t append(const Order& o) {
+            if (slotsLeft_ < 2 || fileIdFor(o.instrument) == kNoId)
+                return appendSlow(o);
+            return appendRecord(o, fileIdFor(o.instrument));
+        }
+
+        // Rend durable tout ce qui a été ajouté (msync), quel que soit le niveau
+        void commit();
+        // commit(), arrêt du thread de fond, libération de la projection ; idempotent
+        void close();
+
+        [[nodiscard]] uint64_t nextSequence() const { return nextSeq_; }
+        // Nombre de msync / fdatasync et temps passé dedans (thread de fond compris)
+        [[nodiscard]] uint64_t syncs()   const { return syncs_.load(std::memory_order_relaxed); }
+        [[nodiscard]] uint64_t syncNs()  const { return syncNs_.load(std::memory_order_relaxed); }
+        [[nodiscard]] size_t   segments() const { return segmentIndex_ + 1; }
+
+        // Relit tout le journal de `dir` dans l'ordre des séquences ; renvoie le
+        // nombre d'ordres relus (0 si le répertoire n'existe pas). Lève
+        // std::runtime_error sur un segment invalide ou une séquence rompue.
+        static uint64_t replay(const std::string& dir,
+                               const std::function<void(uint64_t seq, const Order&)>& handle);
+
+        static Durability  parseDurability(const std::string& s);   // none, async, group, sync
+
+    private:
+        static constexpr uint32_t kNoId = UINT32_MAX;
+
+        uint32_t fileIdFor(Symbol s) const {
+            return s.id() < fileIds_.size() ? fileIds_[s.id()] : kNoId;
+        }
+
+        uint64_t appendRecord(const Order& o, uint32_t fileId) {
+            unsigned char* p = cursor();
+            binfmt::encodeOrder(p + 16, o, fileId, scale_);
+            uint64_t seq = nextSeq_++;
+            seal(p, kOrderRecord, seq);
+            publish();
+            if (durability_ == Durability::Sync ||
+                (durability_ == Durability::Group && ++pending_ >= groupSize_))
+                syncPending();
+            return seq;
+        }
+
+        static constexpr unsigned char kOrderRecord  = 1;
+        static constexpr unsigned char kSymbolRecord = 2;
+
+        unsigned char* cursor() const { return base_ + used_; }
+        // Type, séquence et somme de contrôle, une fois la charge utile en place
+        static void seal(unsigned char* p, unsigned char type, uint64_t key);
+        // Avance la fin écrite (visible du thread de fond)
+        void publish() {
+            used_ += kRecordSize;
+            --slotsLeft_;
+            written_.store(used_, std::memory_order_release);
+        }
+
+        uint64_t appendSlow(const Order& o);     // nouveau symbole ou segment plein
+        void     openSegment(size_t index);      // crée et préalloue
+        void     recoverSegment(size_t index);   // reprend le dernier segment existant
+        void     unmapSegment();
+        void     syncPending();                  // msync [synced_, written_) par l'appelant
+        void     syncRange(size_t from, size_t to);
+        void     syncLoop();
+
+        Options                 opts_;
+        Durability              durability_;
+        size_t                  groupSize_;
+        std::string             dir_;
+        TickScale               scale_{ binfmt::kTickSize };
+
+        // segment courant
+        int                     fd_           = -1;
+        unsigned char*          base_         = nullptr;
+        size_t                  size_         = 0;
+        size_t                  used_         = 0;     // octets écrits (en-tête compris)
+        size_t                  slotsLeft_    = 0;
+        size_t                  segmentIndex_ = 0;
+        std::vector<uint32_t>   fileIds_;              // id global → id du segment (kNoId : absent)
+        uint32_t                symbolCount_  = 0;
+
+        uint64_t                nextSeq_ = 1;
+        size_t                  pending_ = 0;          // Group : ordres non synchronisés
+
+        // synchronisation (appelant ou thread de fond), protégée par mutex_
+        std::mutex              mutex_;
+        std::condition_variable wake_;
+        std::atomic<size_t>     written_{0};
+        size_t                  synced_ = 0;
+        std::atomic<uint64_t>   syncs_{0};
+        std::atomic<uint64_t>   syncNs_{0};
+        bool                    stop_   = false;
+        bool                    closed_ = false;
+        std::thread             syncer_;
+    };
+
+    const char* toString(Journal::Durability d);
+
+} // namespace me
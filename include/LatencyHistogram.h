@@ -0,0 +1,63 @@
+#pragma once
+
+#include "OccupancyBitmap.h"   // highestBit
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+
+namespace me {
+
+    // Histogramme de latences log-linéaire (à la HdrHistogram) : valeurs exactes
+    // jusqu'à 2^kSubBits ns, puis 2^(kSubBits-1) sous-classes par puissance de 2,
+    // soit une erreur relative < 1/64 sur toute la plage 64 bits. Taille fixe,
+    // aucune allocation : record() est un clz, deux décalages et un incrément.
+    class LatencyHistogram {
+    public:
+        static constexpr unsigned kSubBits  = 7;
+        static constexpr uint64_t kSub      = uint64_t{1} << kSubBits;   // classes exactes
+        static constexpr uint64_t kHalf     = kSub / 2;                  // sous-classes par octave
+        static constexpr size_t   kBuckets  = kSub + (64 - kSubBits) * kHalf;
+
+        void record(uint64_t ns) {
+            ++counts_[indexOf(ns)];
+            ++count_;
+            sum_ += ns;
+            if (ns < min_) min_ = ns;
+            if (ns > max_) max_ = ns;
+        }
+
+        void merge(const LatencyHistogram& other);
+        void reset() { *this = LatencyHistogram{}; }
+
+        [[nodiscard]] uint64_t count() const { return count_; }
+        [[nodiscard]] uint64_t min()   const { return count_ ? min_ : 0; }
+        [[nodiscard]] uint64_t max()   const { return max_; }
+        [[nodiscard]] double   mean()  const { return count_ ? static_cast<double>(sum_) / count_ : 0.0; }
+
+        // Plus petite valeur v (borne haute de sa classe) telle que p % des mesures sont ≤ v ;
+        // p dans [0, 100], p = 100 renvoie le max exact
+        [[nodiscard]] uint64_t percentile(double p) const;
+
+        // Ligne « name  n  p50 p99 p99.9 p99.99 max » en ns (voir printHeader)
+        void print(std::ostream& os, std::string_view name) const;
+        static void printHeader(std::ostream& os);
+
+        static size_t indexOf(uint64_t v) {
+            if (v < kSub)
+                return static_cast<size_t>(v);
+            unsigned shift = highestBit(v) - (kSubBits - 1);   // v >> shift dans [kHalf, kSub)
+            return static_cast<size_t>(kSub + (shift - 1) * kHalf + ((v >> shift) - kHalf));
+        }
+        // Plus grande valeur rangée dans la classe `index`
+        static uint64_t highestIn(size_t index);
+
+    private:
+        std::array<uint64_t, kBuckets> counts_{};
+        uint64_t count_ = 0;
+        uint64_t sum_   = 0;
+        uint64_t min_   = UINT64_MAX;
+        uint64_t max_   = 0;
+    };
+
+} // namespace me
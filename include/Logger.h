@@ -1,15 +1,44 @@
 #pragma once
-#include <chrono>
-#include <iomanip>
-#include <iostream>
-#include <string>
 #include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Niveau minimal compilé (0 INFO, 1 WARN, 2 ERROR, 3 aucun), fixé par l'option
+// CMake ME_LOG_LEVEL : les sites d'appel en dessous disparaissent du binaire
+#ifndef ME_LOG_MIN_LEVEL
+#define ME_LOG_MIN_LEVEL 0
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define ME_LOG_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#define ME_LOG_COLD        __attribute__((cold, noinline))
+#else
+#define ME_LOG_UNLIKELY(x) (x)
+#define ME_LOG_COLD
+#endif
 
 namespace me {
     enum class LogLevel { INFO, WARN, ERROR };
 
     // Flag global pour activer/désactiver les logs
     extern std::atomic<bool> g_loggingEnabled;
+    // Interrupteurs par niveau (bit i = LogLevel i), tous actifs par défaut
+    extern std::atomic<unsigned> g_logLevels;
+
+    constexpr bool logCompiled(LogLevel l) {
+        return static_cast<int>(l) >= ME_LOG_MIN_LEVEL;
+    }
+
+    // Le niveau est-il compilé et actif ? Testé avant toute évaluation des arguments
+    inline bool logEnabled(LogLevel l) {
+        return logCompiled(l)
+            && g_loggingEnabled.load(std::memory_order_relaxed)
+            && (g_logLevels.load(std::memory_order_relaxed) >> static_cast<int>(l) & 1u);
+    }
 
     inline const char* toString(LogLevel l) {
         switch (l) {
@@ -20,25 +49,173 @@ namespace me {
         return "UNK";
     }
 
-    inline void log(LogLevel lvl, const std::string& msg) {
-        if (!g_loggingEnabled.load(std::memory_order_relaxed)) return;
-        auto now = std::chrono::system_clock::now();
-        auto tt  = std::chrono::system_clock::to_time_t(now);
-        auto ms  = std::chrono::duration_cast<std::chrono::milliseconds>(
-                       now.time_since_epoch()).count() % 1000;
-        std::cout
-          << std::put_time(std::localtime(&tt), "%F %T")
-          << '.' << std::setfill('0') << std::setw(3) << ms
-          << ' ' << toString(lvl)
-          << ' ' << msg << "\n";
+    // Un message est enregistré tel quel : identifiant de format (adresse du
+    // littéral, "{}" pour chaque argument) et arguments bruts encodés dans un
+    // enregistrement de taille fixe. Le formatage (texte, horodatage, enums)
+    // n'a lieu qu'à l'écriture : tout de suite en mode synchrone, ou plus tard
+    // sur le thread du logger asynchrone (voir AsyncLogging).
+    namespace logdetail {
+
+        enum class Tag : uint8_t { Int, Uint, Float, Bool, Char, Str, Custom };
+
+        constexpr size_t kRecordBytes = 256;
+
+        struct Record {
+            uint64_t      ns;              // horodatage (ns depuis l'epoch)
+            const char*   format;          // littéral du site d'appel
+            LogLevel      level;
+            uint8_t       truncated;       // arguments perdus faute de place
+            uint16_t      used;            // octets utilisés dans data
+            unsigned char data[kRecordBytes - 24];
+        };
+        static_assert(sizeof(Record) == kRecordBytes, "Record : taille inattendue");
+
+        // Formate une valeur brute de type quelconque (enum, petit type trivial)
+        using CustomFormatter = void (*)(std::string& out, const unsigned char* raw);
+
+        template<typename T>
+        void formatCustom(std::string& out, const unsigned char* raw);
+
+        inline bool reserve(Record& r, size_t n) {
+            if (r.truncated || r.used + n > sizeof(r.data)) {
+                r.truncated = 1;
+                return false;
+            }
+            return true;
+        }
+
+        inline void putRaw(Record& r, Tag tag, const void* p, size_t n) {
+            if (!reserve(r, 1 + n)) return;
+            r.data[r.used] = static_cast<unsigned char>(tag);
+            std::memcpy(r.data + r.used + 1, p, n);
+            r.used = static_cast<uint16_t>(r.used + 1 + n);
+        }
+
+        inline void encode(Record& r, std::string_view s) {
+            // chaîne copiée (longueur u16), tronquée à la place restante
+            if (!reserve(r, 3)) return;
+            size_t room = sizeof(r.data) - r.used - 3;
+            auto   len  = static_cast<uint16_t>(s.size() < room ? s.size() : room);
+            r.data[r.used] = static_cast<unsigned char>(Tag::Str);
+            std::memcpy(r.data + r.used + 1, &len, 2);
+            std::memcpy(r.data + r.used + 3, s.data(), len);
+            r.used = static_cast<uint16_t>(r.used + 3 + len);
+            if (len < s.size()) r.truncated = 1;
+        }
+        inline void encode(Record& r, const char* s)        { encode(r, std::string_view(s ? s : "(null)")); }
+        inline void encode(Record& r, const std::string& s) { encode(r, std::string_view(s)); }
+        inline void encode(Record& r, bool v)               { putRaw(r, Tag::Bool, &v, 1); }
+        inline void encode(Record& r, char v)               { putRaw(r, Tag::Char, &v, 1); }
+
+        template<typename T>
+        void encode(Record& r, const T& v) {
+            if constexpr (std::is_floating_point_v<T>) {
+                double d = static_cast<double>(v);
+                putRaw(r, Tag::Float, &d, 8);
+            }
+            else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+                int64_t i = v;
+                putRaw(r, Tag::Int, &i, 8);
+            }
+            else if constexpr (std::is_integral_v<T>) {
+                uint64_t u = v;
+                putRaw(r, Tag::Uint, &u, 8);
+            }
+            else {
+                // enum (formaté par toString) ou petit type trivial (formaté par operator<<),
+                // copié brut avec son formateur
+                static_assert(std::is_trivially_copyable_v<T> && sizeof(T) <= 8,
+                              "argument de log non supporté : passer ses champs");
+                // tag, taille, formateur, octets de la valeur
+                if (!reserve(r, 2 + sizeof(CustomFormatter) + sizeof(T))) return;
+                CustomFormatter f = &formatCustom<T>;
+                r.data[r.used]     = static_cast<unsigned char>(Tag::Custom);
+                r.data[r.used + 1] = static_cast<unsigned char>(sizeof(T));
+                std::memcpy(r.data + r.used + 2, &f, sizeof f);
+                std::memcpy(r.data + r.used + 2 + sizeof f, &v, sizeof(T));
+                r.used = static_cast<uint16_t>(r.used + 2 + sizeof f + sizeof(T));
+            }
+        }
+
+        uint64_t nowNs();
+        // Transmet l'enregistrement au backend courant (synchrone ou asynchrone)
+        void submit(const Record& r);
+        // Texte final « date heure.ms NIVEAU message »
+        void formatRecord(std::string& out, const Record& r);
+        void appendStreamed(std::string& out, const void* value, void (*stream)(void* os, const void* value));
+
+        template<typename T>
+        void formatCustom(std::string& out, const unsigned char* raw) {
+            T v;
+            std::memcpy(&v, raw, sizeof(T));
+            if constexpr (std::is_enum_v<T>) {
+                using me::toString;
+                out += toString(v);
+            }
+            else {
+                appendStreamed(out, &v, [](void* os, const void* value) {
+                    *static_cast<std::ostream*>(os) << *static_cast<const T*>(value);
+                });
+            }
+        }
+
+    } // namespace logdetail
+
+    // Enregistre un message ; `format` doit être un littéral (son adresse identifie le format).
+    // Hors du chemin chaud : appelé par les macros LOG_* une fois le niveau vérifié
+    template<size_t N, typename... Args>
+    ME_LOG_COLD void logFormat(LogLevel lvl, const char (&format)[N], const Args&... args) {
+        logdetail::Record r;
+        r.ns        = logdetail::nowNs();
+        r.format    = format;
+        r.level     = lvl;
+        r.truncated = 0;
+        r.used      = 0;
+        (logdetail::encode(r, args), ...);
+        logdetail::submit(r);
     }
 
-#define LOG_INFO(msg)  ::me::log(::me::LogLevel::INFO,  msg)
-#define LOG_WARN(msg)  ::me::log(::me::LogLevel::WARN,  msg)
-#define LOG_ERROR(msg) ::me::log(::me::LogLevel::ERROR, msg)
+// Niveau désactivé : les arguments ne sont pas évalués ; sous ME_LOG_MIN_LEVEL,
+// le site d'appel n'est même pas généré (mais reste vérifié par le compilateur)
+#define ME_LOG(lvl, ...)                                                  \
+    do {                                                                  \
+        if constexpr (::me::logCompiled(lvl)) {                           \
+            if (ME_LOG_UNLIKELY(::me::logEnabled(lvl)))                   \
+                ::me::logFormat(lvl, __VA_ARGS__);                        \
+        }                                                                 \
+    } while (0)
+
+#define LOG_INFO(...)  ME_LOG(::me::LogLevel::INFO,  __VA_ARGS__)
+#define LOG_WARN(...)  ME_LOG(::me::LogLevel::WARN,  __VA_ARGS__)
+#define LOG_ERROR(...) ME_LOG(::me::LogLevel::ERROR, __VA_ARGS__)
 
     // Pour piloter la flag runtime
     inline void setLoggingEnabled(bool e) {
         g_loggingEnabled.store(e, std::memory_order_relaxed);
     }
+
+    // Active ou coupe un seul niveau (sans effet sur un niveau non compilé)
+    inline void setLogLevelEnabled(LogLevel l, bool e) {
+        unsigned bit = 1u << static_cast<int>(l);
+        if (e) g_logLevels.fetch_or(bit, std::memory_order_relaxed);
+        else   g_logLevels.fetch_and(~bit, std::memory_order_relaxed);
+    }
+
+    // Backend asynchrone : chaque thread qui logue obtient son propre anneau SPSC
+    // sans verrou ; un thread de fond les vide, fusionne les messages par
+    // horodatage, les formate et les écrit sur std::cout. Anneau plein : le
+    // thread appelant attend (aucun message perdu). Sans backend asynchrone
+    // actif, chaque message est formaté et écrit immédiatement.
+    // À arrêter quand les autres threads ont cessé de loguer.
+    void startAsyncLogging(size_t ringCapacity = 4096);
+    void stopAsyncLogging();   // vide tous les anneaux puis arrête le thread ; idempotent
+
+    // RAII : backend asynchrone pour la durée d'une portée (typiquement main)
+    class AsyncLogging {
+    public:
+        explicit AsyncLogging(size_t ringCapacity = 4096) { startAsyncLogging(ringCapacity); }
+        ~AsyncLogging() { stopAsyncLogging(); }
+        AsyncLogging(const AsyncLogging&)            = delete;
+        AsyncLogging& operator=(const AsyncLogging&) = delete;
+    };
 }
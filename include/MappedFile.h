@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace me {
+
+    // Fichier projeté en mémoire en lecture seule (mmap sous POSIX).
+    // Sur les autres plateformes, le contenu est lu d'un bloc dans un tampon :
+    // l'interface reste la même, seule la copie initiale change.
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        explicit MappedFile(std::string const& filename);
+        ~MappedFile();
+
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+        MappedFile(const MappedFile&)            = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        [[nodiscard]] const char*      data() const { return data_; }
+        [[nodiscard]] size_t           size() const { return size_; }
+        [[nodiscard]] std::string_view view() const { return { data_, size_ }; }
+
+    private:
+        void release();
+
+        const char* data_   = nullptr;
+        size_t      size_   = 0;
+        bool        mapped_ = false;   // true : data_ vient de mmap
+        std::string fallback_;         // contenu lu si mmap indisponible
+    };
+
+} // namespace me
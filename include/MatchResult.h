@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Order.h"
+#include "FunctionRef.h"
 #include <cstdint>
 #include <string>
 
@@ -12,6 +13,7 @@ namespace me {
         uint64_t incoming_order_id;  // ID de l’ordre entrant
         uint64_t executed_quantity;  // quantité appariée
         double   execution_price;    // prix d’exécution
+        uint64_t resting_remaining;  // reliquat de l’ordre au repos après ce fill (0 = sorti du carnet)
     };
 
     // Statut à écrire en sortie CSV
@@ -38,7 +40,7 @@ namespace me {
     struct MatchResult {
         uint64_t    timestamp;          // timestamp de l’action
         uint64_t    order_id;           // id de l’ordre entrant
-        std::string instrument;
+        Symbol      instrument;
         Side        side;
         Type        type;
         uint64_t    quantity;           // quantité restante
@@ -50,4 +52,7 @@ namespace me {
         uint64_t    counterparty_id;    // resting_order_id
     };
 
+    // Consommateur des MatchResult produits par le moteur
+    using ResultSink = FunctionRef<void(const MatchResult&)>;
+
 } // namespace me
@@ -3,8 +3,9 @@
 #include "OrderBook.h"
 #include "Order.h"
 #include "MatchResult.h"
+#include "FlatHashMap.h"
 #include <vector>
-#include <unordered_map>
+#include <variant>
 
 namespace me {
 
@@ -12,14 +13,47 @@ namespace me {
     public:
         // traite un ordre et renvoie une liste de MatchResult
         std::vector<MatchResult> process(const Order& o);
+        // traite un ordre en transmettant chaque MatchResult (fills puis acquittement
+        // PENDING/CANCELED/REJECTED) au consommateur, sans conteneur intermédiaire
+        void process(const Order& o, ResultSink sink);
+
+        // Déclare le référentiel d'un instrument : son carnet passe sur l'échelle
+        // de prix dense (ticks entiers, bande bornée). Les ordres LIMIT hors bande
+        // ou hors pas de cotation sont alors REJECTED.
+        void registerInstrument(Symbol instrument, const InstrumentSpec& spec);
+
+        // Pré-dimensionne la table d'état pour `liveOrders` ordres vivants simultanés,
+        // ainsi que le carnet de chaque instrument déjà référencé (registerInstrument) :
+        // tant que ces bornes tiennent, le matching sur ces carnets n'alloue plus
+        void reserve(size_t liveOrders);
+
+        // Nombre d'ordres vivants suivis (ceux qui reposent encore dans un carnet)
+        [[nodiscard]] size_t liveOrders() const { return orders_.size(); }
 
     private:
-        // un carnet par instrument
-        std::unordered_map<std::string, OrderBook> books_;
+        using Book = std::variant<OrderBook, LadderOrderBook>;
+
+        // un carnet par instrument, indexé par l'id interné de l'instrument
+        // (std::map par défaut, échelle dense si référencé)
+        std::vector<Book> books_;
+
+        Book& bookFor(Symbol instrument) {
+            if (instrument.id() >= books_.size())
+                books_.resize(instrument.id() + 1);
+            return books_[instrument.id()];
+        }
+
+        // État d'un ordre vivant : quantité originale (pour MODIFY) et restante
+        struct OrderState {
+            uint64_t original;
+            uint64_t remaining;
+        };
+        // Table unique à adressage ouvert ; une entrée est supprimée dès que
+        // l'ordre atteint un statut terminal, la mémoire reste donc bornée
+        // par le nombre d'ordres au repos
+        FlatHashMap<OrderState> orders_;
 
-        // Pour chaque ordre ID : quantité originale (pour MODIFY) et restante
-        std::unordered_map<uint64_t, uint64_t> originalQty_;
-        std::unordered_map<uint64_t, uint64_t> remainingQty_;
+        void retire(const Order& o, const OrderState& state, uint64_t resting);
     };
 
 } // namespace me
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace me {
+
+    // Index du bit de poids faible / fort d'un mot non nul
+    inline unsigned lowestBit(uint64_t w) {
+#if defined(_MSC_VER)
+        unsigned long i; _BitScanForward64(&i, w); return static_cast<unsigned>(i);
+#else
+        return static_cast<unsigned>(__builtin_ctzll(w));
+#endif
+    }
+    inline unsigned highestBit(uint64_t w) {
+#if defined(_MSC_VER)
+        unsigned long i; _BitScanReverse64(&i, w); return static_cast<unsigned>(i);
+#else
+        return 63u - static_cast<unsigned>(__builtin_clzll(w));
+#endif
+    }
+
+    // Bitmap d'occupation hiérarchique à 3 niveaux : un bit par niveau de prix,
+    // puis un bit par mot non nul du niveau inférieur. La recherche du prochain
+    // niveau occupé coûte au plus quelques ctz/clz, quelle que soit la distance.
+    class OccupancyBitmap {
+    public:
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        explicit OccupancyBitmap(size_t bits = 0) {
+            for (auto& lvl : levels_) {
+                bits = (bits + 63) / 64;
+                lvl.assign(bits == 0 ? 1 : bits, 0);
+            }
+        }
+
+        [[nodiscard]] bool test(size_t i) const {
+            return (levels_[0][i >> 6] >> (i & 63)) & 1u;
+        }
+
+        void set(size_t i) {
+            for (auto& lvl : levels_) {
+                uint64_t& w   = lvl[i >> 6];
+                bool      had = w != 0;
+                w |= uint64_t{1} << (i & 63);
+                if (had) return;            // le niveau supérieur est déjà marqué
+                i >>= 6;
+            }
+        }
+
+        void clear(size_t i) {
+            for (auto& lvl : levels_) {
+                uint64_t& w = lvl[i >> 6];
+                w &= ~(uint64_t{1} << (i & 63));
+                if (w != 0) return;         // le mot reste occupé
+                i >>= 6;
+            }
+        }
+
+        // Premier bit à 1 d'indice >= i, ou npos
+        [[nodiscard]] size_t findNext(size_t i) const {
+            for (size_t lvl = 0; lvl < kLevels; ++lvl) {
+                const auto& words = levels_[lvl];
+                size_t w = i >> 6;
+                if (w >= words.size()) return npos;
+                uint64_t m = words[w] & (~uint64_t{0} << (i & 63));
+                // au sommet, on balaie les quelques mots restants
+                while (m == 0 && lvl == kLevels - 1 && ++w < words.size())
+                    m = words[w];
+                if (m != 0)
+                    return descend(lvl, (w << 6) + lowestBit(m), true);
+                i = w + 1;
+            }
+            return npos;
+        }
+
+        // Dernier bit à 1 d'indice <= i, ou npos
+        [[nodiscard]] size_t findPrev(size_t i) const {
+            for (size_t lvl = 0; lvl < kLevels; ++lvl) {
+                const auto& words = levels_[lvl];
+                size_t w = i >> 6;
+                if (w >= words.size()) {
+                    w = words.size() - 1;
+                    i = (w << 6) | 63;
+                }
+                uint64_t m = words[w] & (~uint64_t{0} >> (63 - (i & 63)));
+                while (m == 0 && lvl == kLevels - 1 && w > 0)
+                    m = words[--w];
+                if (m != 0)
+                    return descend(lvl, (w << 6) + highestBit(m), false);
+                if (w == 0) return npos;
+                i = w - 1;
+            }
+            return npos;
+        }
+
+    private:
+        static constexpr size_t kLevels = 3;
+
+        // Redescend du niveau `lvl` jusqu'au bit de prix, par le bit le plus bas ou le plus haut
+        [[nodiscard]] size_t descend(size_t lvl, size_t pos, bool lowest) const {
+            while (lvl-- > 0) {
+                uint64_t w = levels_[lvl][pos];
+                pos = (pos << 6) + (lowest ? lowestBit(w) : highestBit(w));
+            }
+            return pos;
+        }
+
+        std::vector<uint64_t> levels_[kLevels];
+    };
+
+} // namespace me
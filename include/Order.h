@@ -1,7 +1,9 @@
 // include/Order.h
 #pragma once
 
+#include "SymbolTable.h"
 #include <string>
+#include <string_view>
 #include <cstdint>
 #include <ostream>
 
@@ -17,15 +19,15 @@ namespace me {
     std::string toString(Type);
     std::string toString(Action);
 
-    Side   sideFromString(const std::string&);
-    Type   typeFromString(const std::string&);
-    Action actionFromString(const std::string&);
+    Side   sideFromString(std::string_view);
+    Type   typeFromString(std::string_view);
+    Action actionFromString(std::string_view);
 
     // Représentation d’un ordre
     struct Order {
         uint64_t   timestamp;
         uint64_t   order_id;
-        std::string instrument;
+        Symbol     instrument;   // instrument interné (id dense)
         Side       side;
         Type       type;
         uint64_t   quantity;
@@ -37,11 +39,11 @@ namespace me {
 
         // Usines
         static Order makeLimit( uint64_t ts, uint64_t id,
-                                std::string instr,
+                                Symbol instr,
                                 Side s, uint64_t qty, double p,
                                 Action a );
         static Order makeMarket(uint64_t ts, uint64_t id,
-                                std::string instr,
+                                Symbol instr,
                                 Side s, uint64_t qty,
                                 Action a );
 
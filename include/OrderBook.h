@@ -2,35 +2,81 @@
 
 #include "Order.h"
 #include "MatchResult.h"
-#include <map>
-#include <deque>
+#include "InstrumentSpec.h"
+#include "PriceLevels.h"
+#include "OrderPool.h"
+#include "FlatHashMap.h"
+#include "FunctionRef.h"
 #include <vector>
 #include <algorithm>
 #include <functional>
 
 namespace me {
 
-    // OrderBook pour un seul instrument
-    template<typename Cmp = std::less<double>>
-    using PriceLevel = std::map<double, std::deque<Order>, Cmp>;
+    // Consommateur des fills, appelé au fil du matching
+    using FillSink = FunctionRef<void(const Execution&)>;
 
-    class OrderBook {
+    // OrderBook pour un seul instrument, prix stockés en ticks entiers.
+    // Levels choisit le stockage des niveaux de prix (MapLevels ou LadderLevels).
+    template<template<typename> class Levels>
+    class BasicOrderBook {
     public:
+        BasicOrderBook() : BasicOrderBook(InstrumentSpec{}) {}
+        explicit BasicOrderBook(const InstrumentSpec& spec);
+
         // Traite un ordre (NEW/MODIFY/CANCEL) et renvoie tous les fills générés
         std::vector<Execution> process(const Order& o);
+        // Idem, mais chaque fill est passé à `onFill` dès qu'il est produit (aucun conteneur)
+        void process(const Order& o, FillSink onFill);
         [[nodiscard]] bool empty() const {
             return buyBook_.empty() && sellBook_.empty();
         }
+        // Vrai si le prix d'un LIMIT NEW/MODIFY respecte le pas et la bande de l'instrument
+        [[nodiscard]] bool accepts(const Order& o) const;
+        // Quantité au repos de l'ordre `orderId` (0 s'il n'est pas dans le carnet)
+        [[nodiscard]] uint64_t restingQuantity(uint64_t orderId) const;
+        // Pré-alloue nœuds et index pour `orders` ordres au repos simultanés
+        void reserve(size_t orders);
 
     private:
-        PriceLevel<std::greater<>> buyBook_;   // BUY : prix décroissants
-        PriceLevel<>               sellBook_;  // SELL: prix croissants
+        InstrumentSpec spec_;
+        TickScale      scale_;
+
+        Levels<std::greater<>> buyBook_;   // BUY : prix décroissants
+        Levels<std::less<>>    sellBook_;  // SELL: prix croissants
+
+        // Nœuds des ordres au repos, chaînés dans les FIFO des niveaux
+        OrderPool pool_;
+        uint64_t  seq_ = 0;
+
+        // Handle d'un ordre au repos : file du niveau, nœud et côté
+        // (l'adresse d'une file ne change pas tant que son niveau reste actif)
+        struct Locator {
+            OrderQueue* queue;
+            NodeIndex   node;
+            Side        side;
+        };
+        // Index order_id → handle : CANCEL/MODIFY sans prix ni side
+        FlatHashMap<Locator> index_;
 
         // Helpers
-        std::vector<Execution> matchLimit(const Order& o);
-        std::vector<Execution> matchMarket(const Order& o);
-        void addLimitOrder(const Order& o);
-        void cancelOrder(const Order& o);
+        void matchLimit(const Order& o, FillSink onFill);
+        void matchMarket(const Order& o, FillSink onFill);
+        void addLimitOrder(const Order& o, uint64_t quantity);
+        void cancelOrder(uint64_t orderId);
+
+        // Croise `remaining` contre le côté opposé, jusqu'au prix limite si `bounded`
+        template<typename Book>
+        void sweep(Book& book, const Order& o, bool bounded,
+                   uint64_t& remaining, FillSink onFill);
     };
 
+    // Backend historique : niveaux creux dans un std::map
+    using OrderBook       = BasicOrderBook<MapLevels>;
+    // Backend dense : échelle de prix contiguë, bornée par la bande de l'instrument
+    using LadderOrderBook = BasicOrderBook<LadderLevels>;
+
+    extern template class BasicOrderBook<MapLevels>;
+    extern template class BasicOrderBook<LadderLevels>;
+
 } // namespace me
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "MatchingEngine.h"
+#include "FlatHashMap.h"
+#include "InstrumentSpec.h"
+#include <random>
+#include <string>
+#include <vector>
+
+namespace me {
+
+    // Générateur de flux d'ordres synthétique, proche d'un flux de production :
+    //  - popularité des instruments selon une loi de Zipf (rang 0 = le plus actif) ;
+    //  - prix autour d'un mid par instrument en marche aléatoire, ordres passifs
+    //    concentrés près du mid, une part d'ordres agressifs qui traversent ;
+    //  - proportions NEW limit / NEW market / MODIFY / CANCEL configurables ;
+    //  - suivi des ordres vivants : MODIFY et CANCEL visent des ordres au repos.
+    // Déterministe pour une graine donnée. Le suivi est exact si les résultats
+    // du moteur sont renvoyés par observe() (ce que fait feed()) ; sans retour,
+    // les ordres exécutés restent candidats aux MODIFY / CANCEL.
+    class OrderFlowGenerator {
+    public:
+        struct Options {
+            size_t      instruments     = 10;
+            double      zipfExponent    = 1.1;     // 0 = instruments équiprobables
+            std::string symbolPrefix    = "SYM";   // SYM0, SYM1…
+            double      startPrice      = 100.0;
+            double      tickSize        = 0.01;
+            double      bandFraction    = 0.5;     // bande de prix : ±50 % du prix de départ
+            double      volatilityTicks = 1.0;     // écart-type du pas du mid (par ordre sur l'instrument)
+            double      meanOffsetTicks = 3.0;     // distance moyenne au mid d'un ordre passif
+            unsigned    maxOffsetTicks  = 50;
+            double      aggressiveRatio = 0.1;     // part des NEW / MODIFY limit qui traversent
+            // proportions des messages (normalisées)
+            double      newLimit        = 0.60;
+            double      market          = 0.05;
+            double      modify          = 0.15;
+            double      cancel          = 0.20;
+            uint64_t    minQuantity     = 1;
+            uint64_t    maxQuantity     = 100;
+            uint64_t    seed            = 42;
+            uint64_t    firstOrderId    = 1;
+        };
+
+        enum class Kind { NewLimit, NewMarket, Modify, Cancel };
+        static constexpr size_t kKinds = 4;
+        static Kind        kindOf(const Order& o);
+        static const char* toString(Kind k);
+
+        OrderFlowGenerator() : OrderFlowGenerator(Options{}) {}
+        explicit OrderFlowGenerator(const Options& opts);
+
+        // Prochain ordre du flux
+        Order next();
+
+        // Résultat du moteur pour un ordre déjà émis : met à jour les ordres vivants
+        void observe(const MatchResult& r);
+
+        // Référentiel (pas, bande) de chaque instrument, à déclarer au moteur
+        [[nodiscard]] InstrumentSpec spec() const;
+        [[nodiscard]] const std::vector<Symbol>& symbols() const { return symbols_; }
+        void registerInstruments(MatchingEngine& engine) const;
+
+        // Soumet n ordres au moteur ; chaque résultat est observé puis livré à `sink`
+        void feed(MatchingEngine& engine, size_t n, ResultSink sink);
+
+        [[nodiscard]] size_t liveOrders() const { return live_.size(); }
+
+    private:
+        struct Live {
+            uint64_t id;
+            uint32_t instrument;   // index dans symbols_
+            Side     side;
+            uint64_t remaining;    // reliquat au carnet
+        };
+
+        size_t pickInstrument();
+        Ticks  stepMid(size_t instrument);
+        Ticks  limitPrice(size_t instrument, Side side);
+        uint64_t quantity();
+        void   addLive(const Live& l);
+        void   removeLive(uint64_t id);
+
+        Options                     opts_;
+        TickScale                   scale_;
+        std::mt19937_64             rng_;
+        std::vector<Symbol>         symbols_;
+        std::vector<double>         zipfCdf_;
+        std::vector<Ticks>          mid_;
+        Ticks                       lo_, hi_;        // bornes du mid (bande moins la profondeur)
+        double                      kindCdf_[kKinds];
+        std::vector<Live>           live_;
+        FlatHashMap<size_t>         liveIndex_;      // id → position dans live_
+        uint64_t                    nextId_;
+        uint64_t                    timestamp_ = 0;
+    };
+
+} // namespace me
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "InstrumentSpec.h"
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace me {
+
+    using NodeIndex = uint32_t;
+    constexpr NodeIndex kNullNode = UINT32_MAX;
+
+    // Ordre au repos : uniquement les champs chauds du matching
+    struct OrderNode {
+        uint64_t  order_id;
+        uint64_t  quantity;   // quantité restante
+        Ticks     price;
+        uint64_t  seq;        // numéro d'arrivée dans le carnet (priorité temps)
+        NodeIndex prev;
+        NodeIndex next;       // chaînage FIFO, ou liste libre si le nœud est libre
+    };
+
+    // File FIFO intrusive d'un niveau de prix (tête = plus ancien ordre)
+    struct OrderQueue {
+        NodeIndex head = kNullNode;
+        NodeIndex tail = kNullNode;
+
+        [[nodiscard]] bool empty() const { return head == kNullNode; }
+    };
+
+    // Slab de nœuds de taille fixe, alloués par blocs et recyclés par liste libre.
+    // Les indices restent valides quand le pool grandit ; en régime établi,
+    // acquire/release ne touchent jamais le tas.
+    class OrderPool {
+    public:
+        OrderNode&       operator[](NodeIndex n)       { return chunks_[n >> kChunkBits][n & kChunkMask]; }
+        const OrderNode& operator[](NodeIndex n) const { return chunks_[n >> kChunkBits][n & kChunkMask]; }
+
+        NodeIndex acquire() {
+            if (free_ == kNullNode)
+                grow();
+            NodeIndex n = free_;
+            free_ = (*this)[n].next;
+            return n;
+        }
+
+        void release(NodeIndex n) {
+            (*this)[n].next = free_;
+            free_ = n;
+        }
+
+        void reserve(size_t nodes) {
+            while (chunks_.size() * kChunkSize < nodes)
+                grow();
+        }
+
+        // --- opérations FIFO sur une file de niveau ---
+        void pushBack(OrderQueue& q, NodeIndex n) {
+            auto& node = (*this)[n];
+            node.prev = q.tail;
+            node.next = kNullNode;
+            if (q.tail == kNullNode) q.head = n;
+            else                     (*this)[q.tail].next = n;
+            q.tail = n;
+        }
+
+        void unlink(OrderQueue& q, NodeIndex n) {
+            auto& node = (*this)[n];
+            if (node.prev == kNullNode) q.head = node.next;
+            else                        (*this)[node.prev].next = node.next;
+            if (node.next == kNullNode) q.tail = node.prev;
+            else                        (*this)[node.next].prev = node.prev;
+        }
+
+    private:
+        static constexpr unsigned kChunkBits = 12;
+        static constexpr size_t   kChunkSize = size_t{1} << kChunkBits;
+        static constexpr size_t   kChunkMask = kChunkSize - 1;
+
+        // Nouveau bloc : ses nœuds sont chaînés en tête de la liste libre
+        void grow() {
+            auto base = static_cast<NodeIndex>(chunks_.size() * kChunkSize);
+            chunks_.emplace_back(new OrderNode[kChunkSize]);
+            auto& chunk = chunks_.back();
+            for (size_t i = 0; i < kChunkSize; ++i)
+                chunk[i].next = (i + 1 < kChunkSize) ? base + static_cast<NodeIndex>(i + 1) : free_;
+            free_ = base;
+        }
+
+        std::vector<std::unique_ptr<OrderNode[]>> chunks_;
+        NodeIndex                                 free_ = kNullNode;
+    };
+
+} // namespace me
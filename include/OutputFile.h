@@ -0,0 +1,110 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace me {
+
+    // Fichier de sortie tamponné : les writers formatent directement dans un
+    // grand tampon réutilisé, transmis à l'OS par gros blocs.
+    //
+    // En mode asynchrone, le thread appelant remplit un tampon d'un anneau de
+    // tampons préalloués ; un tampon plein est confié à un thread d'écriture qui
+    // le vide sur disque pendant que l'appelant continue dans le suivant. Si
+    // tous les tampons sont en vol, la politique `backpressure` décide : attendre
+    // le thread d'écriture (Block) ou ajouter un tampon (Grow). La latence de
+    // l'appelant n'est plus liée aux à-coups du système de fichiers.
+    class OutputFile {
+    public:
+        enum class Backpressure { Block, Grow };
+
+        struct Options {
+            size_t       bufferBytes  = 1 << 20;
+            bool         async        = false;
+            size_t       buffers      = 4;                    // taille de l'anneau (mode async)
+            Backpressure backpressure = Backpressure::Block;
+            bool         durable      = false;                // fdatasync avant fermeture
+        };
+
+        explicit OutputFile(const std::string& filename) : OutputFile(filename, Options{}) {}
+        OutputFile(const std::string& filename, const Options& opts);
+        ~OutputFile();
+
+        OutputFile(const OutputFile&)            = delete;
+        OutputFile& operator=(const OutputFile&) = delete;
+
+        // Au moins `n` octets libres à partir du pointeur renvoyé ; à valider par commit()
+        char* reserve(size_t n) {
+            if (used_ + n > cap_)
+                makeRoom(n);
+            return buf_ + used_;
+        }
+        void commit(char* end) { used_ = static_cast<size_t>(end - buf_); }
+
+        void append(std::string_view s) {
+            char* p = reserve(s.size());
+            s.copy(p, s.size());
+            commit(p + s.size());
+        }
+
+        // Transmet le tampon courant à l'OS (async : au thread d'écriture, sans attendre)
+        void flush();
+        // Réécrit `n` octets à `offset` (en-tête complété à la fin) ; attend les écritures en vol
+        void writeAt(uint64_t offset, const void* data, size_t n);
+        // Vide tout, synchronise sur disque si `durable`, ferme ; sans effet au second appel
+        void close();
+
+        // Nombre de fois où l'appelant a dû attendre un tampon libre (Block) ou en ajouter un (Grow)
+        [[nodiscard]] uint64_t stalls()      const { return stalls_; }
+        [[nodiscard]] size_t   bufferCount() const { return pool_.size(); }
+
+    private:
+        void makeRoom(size_t n);
+        void handOff();                       // async : tampon courant → thread d'écriture
+        void drain();                         // async : attend que tout soit écrit
+        void writerLoop();
+        void writeAll(const char* data, size_t n);
+        void rethrowWriterError();
+
+        Options                        opts_;
+        std::string                    filename_;
+#if defined(__unix__) || defined(__APPLE__)
+        int                            fd_   = -1;
+#else
+        std::FILE*                     file_ = nullptr;
+#endif
+        bool                           open_ = false;
+
+        std::vector<std::vector<char>> pool_;      // tampons (1 seul en mode synchrone)
+        size_t                         current_ = 0;
+        char*                          buf_     = nullptr;
+        size_t                         cap_     = 0;
+        size_t                         used_    = 0;
+        uint64_t                       stalls_  = 0;
+
+        // --- mode async, protégé par mutex_ ---
+        std::mutex                     mutex_;
+        std::condition_variable        fullCv_;    // un tampon attend d'être écrit (ou arrêt)
+        std::condition_variable        freeCv_;    // un tampon vient d'être libéré
+        struct Pending {
+            size_t      index;   // tampon dans pool_
+            const char* data;    // stable même si pool_ grandit (Grow)
+            size_t      bytes;
+        };
+        std::deque<Pending>            full_;      // tampons à écrire, dans l'ordre
+        std::vector<size_t>            free_;
+        bool                           writing_ = false;
+        bool                           stop_    = false;
+        std::exception_ptr             error_;
+        std::thread                    writer_;
+    };
+
+} // namespace me
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "CsvParser.h"
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace me {
+
+    // Parsing parallèle d'un fichier CSV d'ordres projeté en mémoire.
+    // Le fichier est découpé en blocs alignés sur les fins de ligne, analysés par
+    // un pool de threads ; les blocs sont livrés dans l'ordre du fichier.
+    // Les erreurs d'un bloc sont numérotées relativement à son début et ne sont
+    // reportées (getErrors(), log) qu'à sa livraison, une fois connu le nombre de
+    // lignes de tous les blocs précédents : les numéros de ligne sont ceux du fichier.
+    // Comme une lecture `while (auto o = parser.next())` de CsvParser, le flux
+    // s'arrête par défaut à la première ligne invalide.
+    class ParallelCsvParser {
+    public:
+        struct Options {
+            size_t threads    = 0;         // 0 : un par cœur
+            size_t chunkBytes = 1 << 20;   // taille visée d'un bloc
+            size_t window     = 0;         // blocs analysés d'avance au plus ; 0 : 2 × threads
+            bool   skipInvalid = false;    // vrai : lignes invalides sautées, le flux continue
+        };
+
+        explicit ParallelCsvParser(std::string const& filename) : ParallelCsvParser(filename, Options{}) {}
+        ParallelCsvParser(std::string const& filename, const Options& opts);
+        ~ParallelCsvParser();
+
+        ParallelCsvParser(const ParallelCsvParser&)            = delete;
+        ParallelCsvParser& operator=(const ParallelCsvParser&) = delete;
+
+        // Ordres valides du bloc suivant, dans l'ordre du fichier ; nullptr en fin de fichier.
+        // Le vecteur reste valide jusqu'à l'appel suivant. La première ligne invalide
+        // est reportée et termine le flux (seuls les ordres qui la précèdent sont
+        // livrés), sauf avec Options::skipInvalid où elle est seulement sautée.
+        const std::vector<Order>* nextBatch();
+
+        std::vector<ParseError> const& getErrors() const { return errors_; }
+        [[nodiscard]] size_t chunkCount()  const { return chunks_.size(); }
+        [[nodiscard]] size_t threadCount() const { return workers_.size(); }
+
+    private:
+        struct Chunk {
+            size_t                  begin, end;   // octets [begin, end) du fichier
+            std::vector<Order>      orders;
+            std::vector<ParseError> errors;       // lignes relatives au début du bloc
+            size_t                  lines = 0;
+            std::exception_ptr      error;
+            bool                    ready = false;
+        };
+
+        void split(size_t bodyStart, size_t chunkBytes);
+        void work();
+
+        MappedFile                file_;
+        std::vector<Chunk>        chunks_;
+        std::vector<ParseError>   errors_;
+        size_t                    lineOffset_ = 1;   // lignes avant le prochain bloc (en-tête)
+        size_t                    window_;
+        bool                      skipInvalid_;
+        bool                      halted_ = false;   // ligne invalide livrée : fin du flux
+
+        std::mutex                mutex_;
+        std::condition_variable   readyCv_;   // un bloc vient d'être analysé
+        std::condition_variable   spaceCv_;   // un bloc vient d'être livré
+        size_t                    nextToParse_ = 0;
+        size_t                    delivered_   = 0;
+        bool                      stop_        = false;
+        std::vector<std::thread>  workers_;
+    };
+
+} // namespace me
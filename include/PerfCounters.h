@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace me {
+
+    // Compteurs matériels du thread courant (perf_event_open, Linux) : cycles,
+    // instructions, défauts de cache L1d / LLC, mauvaises prédictions de branche
+    // et défauts de dTLB. Chaque compteur est ouvert séparément : ceux que le noyau
+    // ou la machine refusent (perf_event_paranoid, VM, autre OS) sont simplement
+    // marqués indisponibles et rien n'est levé. Les valeurs sont corrigées du
+    // multiplexage (temps actif / temps d'activation).
+    class PerfCounters {
+    public:
+        enum Event { Cycles, Instructions, L1dMisses, LlcMisses, BranchMisses, DtlbMisses, kEvents };
+
+        PerfCounters();
+        ~PerfCounters();
+        PerfCounters(const PerfCounters&)            = delete;
+        PerfCounters& operator=(const PerfCounters&) = delete;
+
+        // Compte entre start() et stop() ; plusieurs intervalles s'additionnent
+        void start();
+        void stop();
+        void reset();
+
+        [[nodiscard]] bool available() const;             // au moins un compteur ouvert
+        [[nodiscard]] bool available(Event e) const { return fds_[e] >= 0; }
+        [[nodiscard]] double value(Event e) const { return totals_[e]; }
+        // Raison de l'indisponibilité (vide si tous les compteurs sont ouverts)
+        [[nodiscard]] const std::string& unavailableReason() const { return reason_; }
+
+        static const char* name(Event e);
+
+        // Tableau des compteurs divisés par `units` (ordres, opérations…) ;
+        // une ligne d'explication si aucun n'est disponible
+        void print(std::ostream& os, double units, const char* unitName) const;
+
+    private:
+        int         fds_[kEvents];
+        double      totals_[kEvents] = {};
+        bool        running_ = false;
+        std::string reason_;
+    };
+
+    // RAII : compte pendant la portée
+    class PerfScope {
+    public:
+        explicit PerfScope(PerfCounters& c) : c_(c) { c_.start(); }
+        ~PerfScope() { c_.stop(); }
+        PerfScope(const PerfScope&)            = delete;
+        PerfScope& operator=(const PerfScope&) = delete;
+    private:
+        PerfCounters& c_;
+    };
+
+} // namespace me
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "MatchingEngine.h"
+#include "FunctionRef.h"
+#include <ostream>
+#include <vector>
+
+namespace me {
+
+    // Exécution en pipeline parse → match → write : chaque étage tourne sur son
+    // propre thread (épinglé), les étages échangent des lots par des files SPSC
+    // bornées, et les lots vides reviennent à leur producteur par une file de
+    // retour : aucune allocation en régime établi. Le débit tend vers celui de
+    // l'étage le plus lent plutôt que vers la somme des trois.
+    class Pipeline {
+    public:
+        struct Options {
+            size_t   batchSize   = 4096;   // ordres (ou résultats) par lot
+            size_t   ringBatches = 64;     // lots en circulation entre deux étages
+            bool     pinThreads  = true;
+            unsigned firstCore   = 0;      // parse → firstCore, match → +1, write → +2
+        };
+
+        struct StageStats {
+            const char* name;
+            uint64_t    items   = 0;       // ordres lus / traités, résultats écrits
+            uint64_t    batches = 0;
+            double      seconds = 0.0;     // du démarrage à la fin de l'étage
+            double      busy    = 0.0;     // temps de travail effectif (hors attentes)
+        };
+
+        struct QueueStats {
+            const char* name;
+            size_t      capacity = 0;
+            double      meanOccupancy = 0.0;   // lots en attente, échantillonnés à chaque retrait
+            size_t      maxOccupancy  = 0;
+        };
+
+        struct Stats {
+            StageStats stages[3] = { { "parse" }, { "match" }, { "write" } };
+            QueueStats queues[2] = { { "parse→match" }, { "match→write" } };
+            double     seconds   = 0.0;
+
+            void print(std::ostream& os) const;
+        };
+
+        // Remplit le lot (vide, capacité batchSize) ; false quand la source est épuisée
+        using OrderSource = FunctionRef<bool(std::vector<Order>&)>;
+
+        explicit Pipeline(MatchingEngine& engine) : Pipeline(engine, Options{}) {}
+        Pipeline(MatchingEngine& engine, const Options& opts);
+
+        // Déroule tout le flux ; `source` est appelée depuis le thread parse et
+        // `sink` depuis le thread write, dans l'ordre d'entrée. Une exception d'un
+        // étage arrête les autres et est relancée ici.
+        Stats run(OrderSource source, ResultSink sink);
+
+    private:
+        MatchingEngine& engine_;
+        Options         opts_;
+    };
+
+} // namespace me
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "InstrumentSpec.h"
+#include "OccupancyBitmap.h"
+#include "OrderPool.h"
+#include <map>
+#include <vector>
+#include <functional>
+#include <stdexcept>
+
+namespace me {
+
+    // Stockage des niveaux d'un côté du carnet.
+    // Cmp ordonne les prix du meilleur au moins bon (std::greater<> pour BUY,
+    // std::less<> pour SELL). Interface commune aux deux backends :
+    //   open(t)  → file (OrderQueue) du niveau t, qui devient actif (l'appelant y insère)
+    //   close(t) → le niveau t vient de se vider
+    //   best()   → meilleur niveau actif (précondition : !empty())
+
+    // --- Backend creux : arbre rouge-noir, aucune borne de prix ---
+    template<typename Cmp>
+    class MapLevels {
+    public:
+        using compare = Cmp;
+
+        MapLevels(Ticks /*lo*/, Ticks /*hi*/) {}
+
+        OrderQueue& open(Ticks t)        { return levels_[t]; }
+        void        close(Ticks t)       { levels_.erase(t); }
+        OrderQueue& level(Ticks t)       { return levels_.find(t)->second; }
+
+        [[nodiscard]] bool  empty() const { return levels_.empty(); }
+        [[nodiscard]] Ticks best()  const { return levels_.begin()->first; }
+
+    private:
+        std::map<Ticks, OrderQueue, Cmp> levels_;
+    };
+
+    // --- Backend dense : tableau contigu indexé par l'offset en ticks ---
+    // Un bitmap d'occupation hiérarchique retrouve le prochain niveau non vide
+    // par ctz/clz au lieu de balayer les ticks vides (carnets larges et peu denses).
+    template<typename Cmp>
+    class LadderLevels {
+    public:
+        using compare = Cmp;
+
+        LadderLevels(Ticks lo, Ticks hi)
+          : lo_(lo), best_(0)
+        {
+            if (hi < lo || hi - lo >= kMaxLevels)
+                throw std::invalid_argument("Bande de prix invalide pour le carnet dense");
+            levels_.resize(static_cast<size_t>(hi - lo + 1));
+            occupied_ = OccupancyBitmap(levels_.size());
+        }
+
+        OrderQueue& open(Ticks t) {
+            size_t i = offset(t);
+            if (!occupied_.test(i)) {
+                if (empty() || Cmp{}(t, best_))
+                    best_ = t;
+                occupied_.set(i);
+                ++active_;
+            }
+            return levels_[i];
+        }
+
+        void close(Ticks t) {
+            occupied_.clear(offset(t));
+            if (--active_ == 0 || t != best_)
+                return;
+            // le meilleur niveau s'est vidé : prochain niveau occupé vers les prix moins bons
+            size_t next = kAscending ? occupied_.findNext(offset(t))
+                                     : occupied_.findPrev(offset(t));
+            best_ = lo_ + static_cast<Ticks>(next);
+        }
+
+        OrderQueue& level(Ticks t) { return levels_[offset(t)]; }
+
+        [[nodiscard]] bool  empty() const { return active_ == 0; }
+        [[nodiscard]] Ticks best()  const { return best_; }
+
+    private:
+        static constexpr Ticks kMaxLevels = Ticks{1} << 24;
+        // SELL (std::less) : les prix moins bons sont au-dessus
+        static constexpr bool  kAscending = Cmp{}(0, 1);
+
+        [[nodiscard]] size_t offset(Ticks t) const { return static_cast<size_t>(t - lo_); }
+
+        std::vector<OrderQueue> levels_;
+        OccupancyBitmap         occupied_;   // un bit par niveau non vide
+        Ticks                   lo_;         // tick du premier niveau du tableau
+        size_t                  active_ = 0; // nombre de niveaux non vides
+        Ticks                   best_;       // meilleur niveau actif
+    };
+
+} // namespace me
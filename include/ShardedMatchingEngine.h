@@ -0,0 +1,79 @@
+#pragma once
+
+#include "MatchingEngine.h"
+#include "SpscQueue.h"
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace me {
+
+    // Moteur réparti : les instruments sont partagés entre N threads de matching
+    // (épinglés sur des cœurs), chacun avec ses propres carnets et sa table d'état.
+    // Le thread d'ingestion route chaque ordre vers le shard de son instrument par
+    // une file SPSC, puis relit les résultats dans l'ordre exact de soumission :
+    // la sortie est identique à celle d'un MatchingEngine unique.
+    class ShardedMatchingEngine {
+    public:
+        struct Options {
+            size_t   shards        = 2;
+            size_t   queueCapacity = 1 << 14;  // ordres (entrée) et résultats (sortie) par shard
+            bool     pinThreads    = true;
+            unsigned firstCore     = 1;        // shard k → cœur firstCore + k (le cœur 0 reste à l'ingestion)
+        };
+
+        ShardedMatchingEngine() : ShardedMatchingEngine(Options{}) {}
+        explicit ShardedMatchingEngine(const Options& opts);
+        ~ShardedMatchingEngine();
+
+        ShardedMatchingEngine(const ShardedMatchingEngine&)            = delete;
+        ShardedMatchingEngine& operator=(const ShardedMatchingEngine&) = delete;
+
+        // Référentiel d'un instrument ; uniquement avant le premier submit()
+        void registerInstrument(Symbol instrument, const InstrumentSpec& spec);
+
+        // Thread d'ingestion : soumet un ordre ; les résultats déjà disponibles
+        // sont livrés à `sink` dans l'ordre de soumission
+        void submit(const Order& o, ResultSink sink);
+
+        // Attend la fin du traitement de tous les ordres soumis et livre leurs résultats
+        void flush(ResultSink sink);
+
+        [[nodiscard]] size_t shardCount() const { return shards_.size(); }
+        [[nodiscard]] size_t shardOf(Symbol instrument) const {
+            return instrument.id() % shards_.size();
+        }
+
+    private:
+        struct Outbound {
+            MatchResult result;
+            bool        present;  // false : l'ordre n'a produit aucun résultat
+            bool        last;     // dernier résultat de l'ordre
+            bool        failed;   // le shard a levé une exception sur cet ordre
+        };
+
+        struct Shard {
+            Shard(size_t capacity) : inbound(capacity), outbound(capacity) {}
+
+            MatchingEngine        engine;
+            SpscQueue<Order>      inbound;
+            SpscQueue<Outbound>   outbound;
+            std::exception_ptr    error;
+            std::thread           worker;
+        };
+
+        void start();
+        void run(Shard& shard, unsigned core);
+        // Livre les résultats prêts, dans l'ordre de soumission ; false si rien n'a avancé
+        bool drain(ResultSink sink);
+
+        Options                             opts_;
+        std::vector<std::unique_ptr<Shard>> shards_;
+        SpscQueue<uint32_t>                 route_;    // shard de chaque ordre en vol (local à l'ingestion)
+        std::atomic<bool>                   stop_{false};
+        bool                                started_ = false;
+    };
+
+} // namespace me
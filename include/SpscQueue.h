@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace me {
+
+    // File circulaire bornée sans verrou, un seul producteur / un seul consommateur.
+    // Capacité arrondie à une puissance de 2 ; les index de tête et de queue
+    // vivent sur des lignes de cache distinctes et chaque côté garde une copie
+    // locale de l'index de l'autre pour limiter le trafic de cohérence.
+    template<typename T>
+    class SpscQueue {
+    public:
+        explicit SpscQueue(size_t capacity) {
+            size_t cap = 2;
+            while (cap < capacity) cap <<= 1;
+            buf_.resize(cap);
+            mask_ = cap - 1;
+        }
+
+        SpscQueue(const SpscQueue&)            = delete;
+        SpscQueue& operator=(const SpscQueue&) = delete;
+
+        // --- côté producteur ---
+        bool tryPush(const T& v) {
+            size_t tail = tail_.load(std::memory_order_relaxed);
+            if (tail - cachedHead_ > mask_) {
+                cachedHead_ = head_.load(std::memory_order_acquire);
+                if (tail - cachedHead_ > mask_)
+                    return false;                          // pleine
+            }
+            buf_[tail & mask_] = v;
+            tail_.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        // --- côté consommateur ---
+        // Élément en tête, ou nullptr si la file est vide
+        T* front() {
+            size_t head = head_.load(std::memory_order_relaxed);
+            if (head == cachedTail_) {
+                cachedTail_ = tail_.load(std::memory_order_acquire);
+                if (head == cachedTail_)
+                    return nullptr;
+            }
+            return &buf_[head & mask_];
+        }
+
+        void pop() {
+            head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        bool tryPop(T& out) {
+            T* v = front();
+            if (!v) return false;
+            out = std::move(*v);
+            pop();
+            return true;
+        }
+
+        // Occupation instantanée (approximative vue d'un tiers)
+        [[nodiscard]] size_t size() const {
+            return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+        }
+        [[nodiscard]] size_t capacity() const { return mask_ + 1; }
+
+    private:
+        static constexpr size_t kCacheLine = 64;
+
+        alignas(kCacheLine) std::atomic<size_t> head_{0};   // prochain élément à lire
+        size_t                                  cachedTail_ = 0;
+        alignas(kCacheLine) std::atomic<size_t> tail_{0};   // prochain emplacement à écrire
+        size_t                                  cachedHead_ = 0;
+        alignas(kCacheLine) std::vector<T>      buf_;
+        size_t                                  mask_ = 0;
+    };
+
+} // namespace me
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace me {
+
+    using SymbolId = uint32_t;
+
+    // Table des instruments : chaque nom reçoit une fois pour toutes un id
+    // dense (0, 1, 2…). L'id 0 est réservé au nom vide.
+    // intern() est thread-safe ; name() est une lecture sans verrou.
+    class SymbolTable {
+    public:
+        SymbolTable();
+
+        // Table partagée par tout le processus
+        static SymbolTable& global();
+
+        SymbolId intern(std::string_view name);
+        [[nodiscard]] std::optional<SymbolId> find(std::string_view name) const;
+        [[nodiscard]] const std::string& name(SymbolId id) const {
+            return chunks_[id >> kChunkBits].load(std::memory_order_acquire)[id & kChunkMask];
+        }
+        [[nodiscard]] size_t size() const { return size_.load(std::memory_order_acquire); }
+
+    private:
+        static constexpr unsigned kChunkBits = 10;
+        static constexpr size_t   kChunkSize = size_t{1} << kChunkBits;
+        static constexpr size_t   kChunkMask = kChunkSize - 1;
+        static constexpr size_t   kMaxChunks = 4096;   // ~4 millions d'instruments
+
+        // Les noms ne bougent jamais : blocs fixes, jamais réalloués
+        std::array<std::atomic<std::string*>, kMaxChunks>     chunks_{};
+        std::unique_ptr<std::unique_ptr<std::string[]>[]>     owned_;
+        std::atomic<size_t>                                   size_{0};
+
+        mutable std::shared_mutex                             mutex_;
+        std::unordered_map<std::string_view, SymbolId>        ids_;   // vues sur les noms stockés
+    };
+
+    // Instrument interné : 4 octets copiés dans Order / MatchResult au lieu
+    // d'une std::string. Se construit implicitement depuis un nom.
+    class Symbol {
+    public:
+        Symbol() = default;
+        Symbol(std::string_view name)   : id_(SymbolTable::global().intern(name)) {}
+        Symbol(const std::string& name) : Symbol(std::string_view{name}) {}
+        Symbol(const char* name)        : Symbol(std::string_view{name}) {}
+
+        static Symbol fromId(SymbolId id) { Symbol s; s.id_ = id; return s; }
+
+        [[nodiscard]] SymbolId           id()    const { return id_; }
+        [[nodiscard]] const std::string& name()  const { return SymbolTable::global().name(id_); }
+        [[nodiscard]] bool               empty() const { return id_ == 0; }
+
+        friend bool operator==(Symbol a, Symbol b) { return a.id_ == b.id_; }
+        friend bool operator!=(Symbol a, Symbol b) { return a.id_ != b.id_; }
+        // Comparaison par nom sans interner la chaîne
+        friend bool operator==(Symbol a, const char* n)        { return a.name() == n; }
+        friend bool operator==(Symbol a, const std::string& n) { return a.name() == n; }
+
+        friend std::ostream& operator<<(std::ostream& os, Symbol s) { return os << s.name(); }
+
+    private:
+        SymbolId id_ = 0;
+    };
+
+} // namespace me
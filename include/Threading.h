@@ -0,0 +1,38 @@
+#pragma once
+
+#include <thread>
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace me {
+
+    // Épingle le thread courant sur un cœur (Linux) ; renvoie false si
+    // l'affinité n'est pas supportée ou refusée, le thread tourne alors librement
+    bool pinCurrentThread(unsigned core);
+
+    // Pause d'attente active : libère les ressources du cœur voisin (SMT)
+    inline void cpuRelax() {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+        _mm_pause();
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+    // Attente active bornée : quelques pauses, puis on rend la main à l'OS
+    // (indispensable quand il y a plus de threads actifs que de cœurs)
+    class Backoff {
+    public:
+        void pause() {
+            if (++spins_ < kSpinLimit) cpuRelax();
+            else                       std::this_thread::yield();
+        }
+        void reset() { spins_ = 0; }
+
+    private:
+        static constexpr unsigned kSpinLimit = 64;
+        unsigned spins_ = 0;
+    };
+
+} // namespace me
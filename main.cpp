@@ -1,39 +1,241 @@
 #include "CsvParser.h"
+#include "ParallelCsvParser.h"
+#include "BinaryReader.h"
+#include "BinaryWriter.h"
 #include "MatchingEngine.h"
+#include "ShardedMatchingEngine.h"
+#include "Pipeline.h"
 #include "CsvWriter.h"
+#include "Journal.h"
+#include "Logger.h"
+#include <algorithm>
 #include <iostream>
 #include <filesystem>
 #include <optional>
+#include <string>
+#include <vector>
 
 namespace fs = std::filesystem;
 
-int main() {
+namespace {
+
+    // Empreinte cumulée d'une suite d'ordres (FNV-1a sur les champs, prix en ticks
+    // comme dans le journal) : vérifie que l'entrée commence par les ordres journalisés
+    uint64_t fold(uint64_t h, const me::Order& o) {
+        static const me::TickScale scale{ me::binfmt::kTickSize };
+        const uint64_t fields[] = {
+            o.timestamp, o.order_id, o.instrument.id(), o.quantity,
+            static_cast<uint64_t>(scale.toTicks(o.price)),
+            static_cast<uint64_t>(o.side) << 16 | static_cast<uint64_t>(o.type) << 8
+                                               | static_cast<uint64_t>(o.action)
+        };
+        for (uint64_t v : fields)
+            h = (h ^ v) * 0x100000001b3ULL;
+        return h;
+    }
+    constexpr uint64_t kFoldSeed = 0xcbf29ce484222325ULL;
+
+}
+
+// Usage : app [--input F] [--output F] [--shards N] [--parse-threads N]
+//   --input F         : ordres en CSV ou au format binaire de csv2bin (détecté à l'en-tête)
+//   --output F        : résultats en CSV, ou en binaire si F finit par ".bin"
+//   --shards N        : N threads de matching, instruments répartis entre eux
+//   --parse-threads N : parsing du CSV par blocs sur N threads (arrêt à la première ligne invalide)
+//   --async-output    : écriture des résultats par un thread dédié, synchronisée sur disque à la fin
+//   --pipeline        : lecture, matching et écriture sur trois threads épinglés, bilan par étage
+//   --journal D       : journal d'écriture anticipée dans le répertoire D ; au démarrage les
+//                       ordres déjà journalisés sont rejoués (carnets reconstruits, résultats
+//                       réémis) et sautés dans l'entrée, qui doit commencer par eux (même
+//                       fichier) ; chaque ordre suivant est journalisé avant d'être traité
+//   --durability L    : none, async, group (défaut) ou sync, voir Journal
+int main(int argc, char** argv) {
     try {
         // 1) On construit le chemin vers data/ via la macro DATA_DIR
         fs::path dataDir   = fs::path(DATA_DIR);
         fs::path inputPath = dataDir / "input.csv";
         fs::path outputPath= dataDir / "output.csv";
 
+        size_t shards       = 0;   // 0 = moteur mono-thread
+        size_t parseThreads = 0;   // 0 = parser séquentiel
+        bool   pipeline     = false;
+        me::OutputFile::Options output;
+        std::string             journalDir;
+        me::Journal::Options    journalOpts;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--shards" && i + 1 < argc)
+                shards = std::stoul(argv[++i]);
+            else if (arg == "--parse-threads" && i + 1 < argc)
+                parseThreads = std::stoul(argv[++i]);
+            else if (arg == "--pipeline")
+                pipeline = true;
+            else if (arg == "--async-output") {
+                output.async   = true;
+                output.durable = true;
+            }
+            else if (arg == "--journal" && i + 1 < argc)
+                journalDir = argv[++i];
+            else if (arg == "--durability" && i + 1 < argc)
+                journalOpts.durability = me::Journal::parseDurability(argv[++i]);
+            else if (arg == "--input" && i + 1 < argc)
+                inputPath = argv[++i];
+            else if (arg == "--output" && i + 1 < argc)
+                outputPath = argv[++i];
+            else
+                throw std::runtime_error("Argument inconnu : " + arg);
+        }
+        if (pipeline && shards > 0)
+            throw std::runtime_error("--pipeline et --shards sont incompatibles");
+
         if (!fs::exists(inputPath)) {
             throw std::runtime_error("Le fichier « " + inputPath.string() + " » est introuvable.");
         }
 
         // 2) Initialisation des composants
-        me::CsvParser      parser(inputPath.string());
-        me::CsvWriter      writer(outputPath.string());
-        me::MatchingEngine engine;
+        // logs formatés et écrits par un thread de fond : le matching n'attend pas la console
+        me::AsyncLogging logging;
+        std::optional<me::CsvParser>         parser;
+        std::optional<me::ParallelCsvParser> parallel;
+        std::optional<me::BinaryOrderReader> binary;
+        if (me::isBinaryOrderFile(inputPath.string())) binary.emplace(inputPath.string());
+        else if (parseThreads == 0)                    parser.emplace(inputPath.string());
+        else                                           parallel.emplace(inputPath.string(),
+                                                           me::ParallelCsvParser::Options{ parseThreads });
+
+        std::optional<me::CsvWriter>          writer;
+        std::optional<me::BinaryResultWriter> binaryWriter;
+        if (outputPath.extension() == ".bin") binaryWriter.emplace(outputPath.string(), output);
+        else                                  writer.emplace(outputPath.string(), output);
+        auto sink = [&](const me::MatchResult& r) {
+            if (writer) writer->write(r);
+            else        binaryWriter->write(r);
+        };
+
+        // Journal : ouvert d'abord (une fin interrompue est effacée), puis relu dans le
+        // moteur avant tout nouvel ordre ; ses résultats sont réémis, la sortie est
+        // donc celle d'une exécution d'un seul tenant
+        std::optional<me::Journal> journal;
+        if (!journalDir.empty())
+            journal.emplace(journalDir, journalOpts);
+        uint64_t journaled = 0, journalDigest = kFoldSeed;
+        auto recover = [&](auto&& process) {
+            if (!journal) return;
+            journaled = me::Journal::replay(journalDir, [&](uint64_t, const me::Order& o) {
+                journalDigest = fold(journalDigest, o);
+                process(o);
+            });
+            LOG_INFO("Journal : {} ordre(s) rejoué(s) depuis {}", journaled, journalDir);
+        };
+
+        // Ordre lu dans l'entrée : faux s'il a déjà été journalisé (et rejoué), sinon
+        // journalisé puis à traiter. L'entrée doit commencer par les ordres du journal.
+        uint64_t skipped = 0, inputDigest = kFoldSeed;
+        auto admit = [&](const me::Order& o) {
+            if (skipped < journaled) {
+                inputDigest = fold(inputDigest, o);
+                if (++skipped == journaled && inputDigest != journalDigest)
+                    throw std::runtime_error("Le journal « " + journalDir +
+                                             " » ne correspond pas au début de l'entrée");
+                return false;
+            }
+            if (journal) journal->append(o);
+            return true;
+        };
+
+        // Ordres dans l'ordre du fichier, quel que soit le format d'entrée,
+        // journalisés avant d'être confiés au moteur
+        auto forEachOrder = [&](auto&& process) {
+            auto handle = [&](const me::Order& o) {
+                if (admit(o)) process(o);
+            };
+            if (binary) {
+                while (auto maybe = binary->next())
+                    handle(*maybe);
+                return;
+            }
+            if (parser) {
+                while (auto maybe = parser->next())
+                    handle(*maybe);
+                return;
+            }
+            while (auto batch = parallel->nextBatch())
+                for (auto const& o : *batch)
+                    handle(o);
+        };
 
         // 3) Boucle principale de matching
-        while (auto maybe = parser.next()) {
-            const auto& order   = *maybe;
-            // process() renvoie désormais un vecteur de MatchResult
-            auto        results = engine.process(order);
-            // on écrit directement ces MatchResult dans le CSV
-            writer.writeOrder(order, results);
+        if (pipeline) {
+            // le lecteur parallèle livre déjà des lots : on les recopie dans ceux du pipeline
+            const std::vector<me::Order>* pending = nullptr;
+            size_t                        offset  = 0;
+            auto source = [&](std::vector<me::Order>& batch) {
+                size_t room = batch.capacity();
+                if (parallel) {
+                    while (batch.size() < room) {
+                        if (!pending || offset == pending->size()) {
+                            pending = parallel->nextBatch();
+                            offset  = 0;
+                            if (!pending) return false;
+                        }
+                        size_t n = std::min(room - batch.size(), pending->size() - offset);
+                        batch.insert(batch.end(), pending->begin() + offset, pending->begin() + offset + n);
+                        offset += n;
+                    }
+                    return true;
+                }
+                while (batch.size() < room) {
+                    auto maybe = binary ? binary->next() : parser->next();
+                    if (!maybe) return false;
+                    batch.push_back(*maybe);
+                }
+                return true;
+            };
+            // lot journalisé par le thread de lecture, avant de partir au matching ;
+            // les ordres déjà rejoués en sont retirés
+            auto admitted = [&](std::vector<me::Order>& batch) {
+                size_t first = batch.size();
+                bool   more  = true;
+                while (more && batch.size() == first) {
+                    more = source(batch);
+                    size_t keep = first;
+                    for (size_t k = first; k < batch.size(); ++k)
+                        if (admit(batch[k])) batch[keep++] = batch[k];
+                    batch.erase(batch.begin() + static_cast<std::ptrdiff_t>(keep), batch.end());
+                }
+                return more;
+            };
+            me::MatchingEngine engine;
+            recover([&](const me::Order& o) { engine.process(o, sink); });
+            auto stats = me::Pipeline(engine).run(admitted, sink);
+            me::stopAsyncLogging();   // logs vidés avant le bilan
+            stats.print(std::cout);
         }
+        else if (shards == 0) {
+            me::MatchingEngine engine;
+            recover([&](const me::Order& o) { engine.process(o, sink); });
+            // chaque MatchResult part directement dans le CSV, sans vecteur intermédiaire
+            forEachOrder([&](const me::Order& o) { engine.process(o, sink); });
+        }
+        else {
+            // même sortie, ordre compris : les résultats sont relus dans l'ordre d'entrée
+            me::ShardedMatchingEngine engine({ shards });
+            recover([&](const me::Order& o) { engine.submit(o, sink); });
+            forEachOrder([&](const me::Order& o) { engine.submit(o, sink); });
+            engine.flush(sink);
+        }
+
+        if (skipped < journaled)
+            throw std::runtime_error("L'entrée compte moins d'ordres que le journal « " + journalDir + " »");
+
+        // fermeture explicite : une erreur d'écriture différée est remontée ici
+        if (journal) journal->close();
+        if (binaryWriter) binaryWriter->close();
+        else              writer->close();
 
         // 4) Affichage des éventuelles erreurs de parsing
-        const auto& errs = parser.getErrors();
+        static const std::vector<me::ParseError> none;
+        const auto& errs = parser ? parser->getErrors() : parallel ? parallel->getErrors() : none;
         if (!errs.empty()) {
             std::cerr << "\n=== Erreurs de parsing (" << errs.size() << ") ===\n";
             for (auto const& e : errs) {
@@ -0,0 +1,23 @@
+#include "AllocationCounter.h"
+#include <atomic>
+
+namespace me::alloc {
+
+namespace {
+    // Initialisation constante : utilisable depuis operator new, même avant main
+    thread_local Counts t_counts;
+    std::atomic<bool>   g_installed{false};
+}
+
+Counts current()       { return t_counts; }
+bool   hooksInstalled() { return g_installed.load(std::memory_order_relaxed); }
+
+void recordAllocation(size_t bytes) {
+    ++t_counts.allocations;
+    t_counts.bytes += bytes;
+}
+
+void recordDeallocation()  { ++t_counts.deallocations; }
+void markHooksInstalled()  { g_installed.store(true, std::memory_order_relaxed); }
+
+} // namespace me::alloc
@@ -0,0 +1,65 @@
+// Remplacement des operator new / delete globaux pour compter les allocations
+// (voir AllocationCounter.h). Compilé dans la bibliothèque objet `alloc_hooks` :
+// seuls les exécutables qui la lient sont instrumentés.
+#include "AllocationCounter.h"
+#include <cstdlib>
+#include <new>
+
+namespace {
+    struct Install {
+        Install() { me::alloc::markHooksInstalled(); }
+    } g_install;
+
+    void* allocate(std::size_t n) {
+        me::alloc::recordAllocation(n);
+        if (void* p = std::malloc(n ? n : 1))
+            return p;
+        throw std::bad_alloc();
+    }
+
+    void* allocateAligned(std::size_t n, std::align_val_t al) {
+        me::alloc::recordAllocation(n);
+        auto   a    = static_cast<std::size_t>(al);
+        size_t size = (n + a - 1) / a * a;   // aligned_alloc : taille multiple de l'alignement
+        if (void* p = std::aligned_alloc(a, size ? size : a))
+            return p;
+        throw std::bad_alloc();
+    }
+
+    void release(void* p) noexcept {
+        if (!p) return;
+        me::alloc::recordDeallocation();
+        std::free(p);
+    }
+}
+
+void* operator new(std::size_t n)                                   { return allocate(n); }
+void* operator new[](std::size_t n)                                 { return allocate(n); }
+void* operator new(std::size_t n, std::align_val_t al)              { return allocateAligned(n, al); }
+void* operator new[](std::size_t n, std::align_val_t al)            { return allocateAligned(n, al); }
+
+void* operator new(std::size_t n, const std::nothrow_t&) noexcept {
+    try { return allocate(n); } catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t n, const std::nothrow_t&) noexcept {
+    try { return allocate(n); } catch (...) { return nullptr; }
+}
+void* operator new(std::size_t n, std::align_val_t al, const std::nothrow_t&) noexcept {
+    try { return allocateAligned(n, al); } catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t n, std::align_val_t al, const std::nothrow_t&) noexcept {
+    try { return allocateAligned(n, al); } catch (...) { return nullptr; }
+}
+
+void operator delete(void* p) noexcept                                        { release(p); }
+void operator delete[](void* p) noexcept                                      { release(p); }
+void operator delete(void* p, std::size_t) noexcept                           { release(p); }
+void operator delete[](void* p, std::size_t) noexcept                         { release(p); }
+void operator delete(void* p, std::align_val_t) noexcept                      { release(p); }
+void operator delete[](void* p, std::align_val_t) noexcept                    { release(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept         { release(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept       { release(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept                 { release(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept               { release(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept   { release(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { release(p); }
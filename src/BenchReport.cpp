@@ -0,0 +1,506 @@
+#include "BenchReport.h"
+#include "LatencyHistogram.h"
+#include "PerfCounters.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+// Renseignés par CMake à la configuration
+#ifndef ME_GIT_REVISION
+#define ME_GIT_REVISION "inconnue"
+#endif
+#ifndef ME_BUILD_TYPE
+#define ME_BUILD_TYPE ""
+#endif
+
+namespace me {
+
+namespace {
+
+    // --- JSON : juste ce qu'il faut pour relire nos rapports et ceux de Google Benchmark
+
+    struct Json {
+        enum Type { Null, Bool, Number, String, Array, Object };
+
+        Type                     type = Null;
+        bool                     boolean = false;
+        double                   number = 0;
+        std::string              text;
+        std::vector<Json>        items;   // éléments (Array) ou valeurs (Object)
+        std::vector<std::string> keys;    // clés (Object), alignées sur items
+
+        const Json* get(const std::string& key) const {
+            for (size_t i = 0; i < keys.size(); ++i)
+                if (keys[i] == key) return &items[i];
+            return nullptr;
+        }
+        std::string string(const std::string& key) const {
+            const Json* v = get(key);
+            return v && v->type == String ? v->text : std::string();
+        }
+    };
+
+    class JsonParser {
+    public:
+        explicit JsonParser(const std::string& s) : s_(s) {}
+
+        Json parseDocument() {
+            Json v = parseValue();
+            skipSpace();
+            if (pos_ != s_.size()) fail("contenu après la fin du document");
+            return v;
+        }
+
+    private:
+        [[noreturn]] void fail(const std::string& what) const {
+            throw std::runtime_error("JSON invalide : " + what + " (position " + std::to_string(pos_) + ")");
+        }
+
+        void skipSpace() {
+            while (pos_ < s_.size() && std::isspace(static_cast<unsigned char>(s_[pos_]))) ++pos_;
+        }
+
+        bool consume(char c) {
+            skipSpace();
+            if (pos_ < s_.size() && s_[pos_] == c) { ++pos_; return true; }
+            return false;
+        }
+
+        void expect(char c) {
+            if (!consume(c)) fail(std::string("« ") + c + " » attendu");
+        }
+
+        bool keyword(const char* word) {
+            size_t n = std::char_traits<char>::length(word);
+            if (s_.compare(pos_, n, word) != 0) return false;
+            pos_ += n;
+            return true;
+        }
+
+        Json parseValue() {
+            skipSpace();
+            if (pos_ >= s_.size()) fail("fin de document inattendue");
+            Json v;
+            char c = s_[pos_];
+            if (c == '{') {
+                ++pos_;
+                v.type = Json::Object;
+                if (consume('}')) return v;
+                do {
+                    skipSpace();
+                    v.keys.push_back(parseString());
+                    expect(':');
+                    v.items.push_back(parseValue());
+                } while (consume(','));
+                expect('}');
+            }
+            else if (c == '[') {
+                ++pos_;
+                v.type = Json::Array;
+                if (consume(']')) return v;
+                do v.items.push_back(parseValue()); while (consume(','));
+                expect(']');
+            }
+            else if (c == '"') {
+                v.type = Json::String;
+                v.text = parseString();
+            }
+            else if (keyword("true"))  { v.type = Json::Bool; v.boolean = true; }
+            else if (keyword("false")) { v.type = Json::Bool; }
+            else if (keyword("null"))  { v.type = Json::Null; }
+            else {
+                const char* begin = s_.c_str() + pos_;
+                char*       end   = nullptr;
+                v.type   = Json::Number;
+                v.number = std::strtod(begin, &end);
+                if (end == begin) fail("valeur attendue");
+                pos_ += static_cast<size_t>(end - begin);
+            }
+            return v;
+        }
+
+        std::string parseString() {
+            if (pos_ >= s_.size() || s_[pos_] != '"') fail("chaîne attendue");
+            ++pos_;
+            std::string out;
+            while (pos_ < s_.size() && s_[pos_] != '"') {
+                char c = s_[pos_++];
+                if (c != '\\') { out += c; continue; }
+                if (pos_ >= s_.size()) break;
+                char e = s_[pos_++];
+                switch (e) {
+                    case 'n': out += '\n'; break;
+                    case 't': out += '\t'; break;
+                    case 'r': out += '\r'; break;
+                    case 'b': out += '\b'; break;
+                    case 'f': out += '\f'; break;
+                    case 'u': {
+                        // \uXXXX : seuls les points de code ASCII sont restitués tels quels
+                        if (pos_ + 4 > s_.size()) fail("séquence \\u tronquée");
+                        unsigned long cp = std::stoul(s_.substr(pos_, 4), nullptr, 16);
+                        out += cp < 0x80 ? static_cast<char>(cp) : '?';
+                        pos_ += 4;
+                        break;
+                    }
+                    default: out += e; break;
+                }
+            }
+            if (pos_ >= s_.size()) fail("chaîne non terminée");
+            ++pos_;
+            return out;
+        }
+
+        const std::string& s_;
+        size_t             pos_ = 0;
+    };
+
+    void writeString(std::ostream& os, const std::string& s) {
+        os << '"';
+        for (char c : s) {
+            switch (c) {
+                case '"':  os << "\\\""; break;
+                case '\\': os << "\\\\"; break;
+                case '\n': os << "\\n";  break;
+                case '\t': os << "\\t";  break;
+                case '\r': os << "\\r";  break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                        os << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                           << static_cast<int>(c) << std::dec << std::setfill(' ');
+                    else
+                        os << c;
+            }
+        }
+        os << '"';
+    }
+
+    void writeNumber(std::ostream& os, double v) {
+        if (std::isfinite(v)) os << v;
+        else                  os << "null";
+    }
+
+    // « L1d misses » → « l1d_misses »
+    std::string metricName(const std::string& s) {
+        std::string out;
+        for (char c : s)
+            out += c == ' ' ? '_' : static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        return out;
+    }
+
+    std::string isoDate() {
+        std::time_t t = std::time(nullptr);
+        std::tm     tm{};
+        gmtime_r(&t, &tm);
+        char buf[32];
+        std::strftime(buf, sizeof buf, "%Y-%m-%dT%H:%M:%SZ", &tm);
+        return buf;
+    }
+
+    // Quantile 97,5 % de la loi de Student (IC bilatéral à 95 %). Le degré de
+    // liberté est arrondi par défaut : l'intervalle n'est jamais trop étroit
+    double studentT975(double df) {
+        static const double kTable[] = {
+            12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+             2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+             2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042,
+        };
+        if (!(df >= 1)) return kTable[0];
+        if (df < 31)    return kTable[static_cast<size_t>(df) - 1];
+        if (df < 40)    return 2.042;
+        if (df < 60)    return 2.021;
+        if (df < 120)   return 2.000;
+        return 1.960;
+    }
+
+    void meanVariance(const std::vector<double>& v, double& mean, double& var) {
+        mean = 0;
+        for (double x : v) mean += x;
+        mean /= static_cast<double>(v.size());
+        var = 0;
+        for (double x : v) var += (x - mean) * (x - mean);
+        var = v.size() > 1 ? var / static_cast<double>(v.size() - 1) : 0.0;
+    }
+
+    // Sortie JSON de Google Benchmark : une métrique par compteur et par
+    // benchmark, un échantillon par répétition (les agrégats sont ignorés)
+    void importGoogleBenchmark(const Json& doc, BenchReport& report) {
+        const Json* list = doc.get("benchmarks");
+        for (const Json& b : list->items) {
+            std::string runType = b.string("run_type");
+            if (!runType.empty() && runType != "iteration")
+                continue;
+            std::string name = b.string("run_name");
+            if (name.empty()) name = b.string("name");
+            std::string timeUnit = b.string("time_unit");
+            if (timeUnit.empty()) timeUnit = "ns";
+
+            for (size_t i = 0; i < b.keys.size(); ++i) {
+                const std::string& key = b.keys[i];
+                if (b.items[i].type != Json::Number || key == "iterations" || key == "threads"
+                    || key == "repetitions" || key == "repetition_index"
+                    || key == "family_index" || key == "per_family_instance_index")
+                    continue;
+                // temps et compteurs utilisateur (op, compteurs matériels…) : plus bas = mieux ;
+                // débits (items_per_second, bytes_per_second) : plus haut = mieux
+                bool rate = key.size() > 11 && key.compare(key.size() - 11, 11, "_per_second") == 0;
+                std::string unit = key == "real_time" || key == "cpu_time" ? timeUnit
+                                 : key == "op" ? "s"   // compteur inversé : secondes par opération
+                                 : rate ? key.substr(0, key.find('_')) + "/s" : std::string();
+                report.add(name + "." + key, unit, rate, b.items[i].number);
+            }
+        }
+    }
+
+} // namespace
+
+BenchReport::BenchReport(std::string benchmark)
+  : benchmark_(std::move(benchmark)),
+    gitRevision_(currentGitRevision()),
+    cpuModel_(currentCpuModel()),
+    date_(isoDate()),
+    buildType_(ME_BUILD_TYPE)
+{
+}
+
+void BenchReport::add(const std::string& name, const std::string& unit, bool higherIsBetter, double value) {
+    auto it = std::find_if(metrics_.begin(), metrics_.end(),
+                           [&](const Metric& m) { return m.name == name; });
+    if (it == metrics_.end()) {
+        metrics_.push_back({ name, unit, higherIsBetter, {} });
+        it = metrics_.end() - 1;
+    }
+    it->samples.push_back(value);
+}
+
+void BenchReport::addLatency(const std::string& prefix, const LatencyHistogram& h) {
+    if (h.count() == 0)
+        return;
+    add(prefix + ".p50",    "ns", false, static_cast<double>(h.percentile(50)));
+    add(prefix + ".p99",    "ns", false, static_cast<double>(h.percentile(99)));
+    add(prefix + ".p99.9",  "ns", false, static_cast<double>(h.percentile(99.9)));
+    add(prefix + ".p99.99", "ns", false, static_cast<double>(h.percentile(99.99)));
+    add(prefix + ".max",    "ns", false, static_cast<double>(h.max()));
+    add(prefix + ".mean",   "ns", false, h.mean());
+}
+
+void BenchReport::addCounters(const std::string& prefix, const PerfCounters& c, double units, const std::string& unit) {
+    if (units <= 0)
+        return;
+    for (int e = 0; e < PerfCounters::kEvents; ++e) {
+        auto ev = static_cast<PerfCounters::Event>(e);
+        if (c.available(ev))
+            add(prefix + "." + metricName(PerfCounters::name(ev)), "/" + unit, false, c.value(ev) / units);
+    }
+}
+
+void BenchReport::setParam(const std::string& key, const std::string& value) {
+    for (auto& [k, v] : params_)
+        if (k == key) { v = value; return; }
+    params_.emplace_back(key, value);
+}
+
+const BenchReport::Metric* BenchReport::find(const std::string& name) const {
+    for (const auto& m : metrics_)
+        if (m.name == name) return &m;
+    return nullptr;
+}
+
+void BenchReport::write(std::ostream& os) const {
+    auto oldPrecision = os.precision(std::numeric_limits<double>::max_digits10);
+
+    os << "{\n  \"benchmark\": ";    writeString(os, benchmark_);
+    os << ",\n  \"git_revision\": "; writeString(os, gitRevision_);
+    os << ",\n  \"cpu_model\": ";    writeString(os, cpuModel_);
+    os << ",\n  \"date\": ";         writeString(os, date_);
+    os << ",\n  \"build_type\": ";   writeString(os, buildType_);
+
+    os << ",\n  \"params\": {";
+    for (size_t i = 0; i < params_.size(); ++i) {
+        os << (i ? ", " : "");
+        writeString(os, params_[i].first);
+        os << ": ";
+        writeString(os, params_[i].second);
+    }
+    os << "}";
+
+    os << ",\n  \"metrics\": [";
+    for (size_t i = 0; i < metrics_.size(); ++i) {
+        const Metric& m = metrics_[i];
+        os << (i ? ",\n" : "\n") << "    { \"name\": ";
+        writeString(os, m.name);
+        os << ", \"unit\": ";
+        writeString(os, m.unit);
+        os << ", \"better\": \"" << (m.higherIsBetter ? "higher" : "lower") << "\", \"samples\": [";
+        for (size_t j = 0; j < m.samples.size(); ++j) {
+            os << (j ? ", " : "");
+            writeNumber(os, m.samples[j]);
+        }
+        os << "] }";
+    }
+    os << (metrics_.empty() ? "]\n}\n" : "\n  ]\n}\n");
+
+    os.precision(oldPrecision);
+}
+
+void BenchReport::writeFile(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out)
+        throw std::runtime_error("Impossible d'ouvrir « " + path + " »");
+    write(out);
+    if (!out)
+        throw std::runtime_error("Écriture impossible dans « " + path + " »");
+}
+
+BenchReport BenchReport::readFile(const std::string& path) {
+    std::ifstream in(path);
+    if (!in)
+        throw std::runtime_error("Impossible d'ouvrir « " + path + " »");
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    return parse(ss.str());
+}
+
+BenchReport BenchReport::parse(const std::string& json) {
+    Json doc = JsonParser(json).parseDocument();
+    if (doc.type != Json::Object)
+        throw std::runtime_error("JSON invalide : objet attendu à la racine");
+
+    BenchReport report;
+    report.gitRevision_.clear();
+    report.cpuModel_.clear();
+    report.date_.clear();
+    report.buildType_.clear();
+
+    if (doc.get("benchmarks")) {
+        // Google Benchmark : contexte en tête (cpu_model / git_revision si le bench les y ajoute)
+        if (const Json* ctx = doc.get("context")) {
+            std::string exe = ctx->string("executable");
+            report.benchmark_   = exe.substr(exe.find_last_of('/') + 1);
+            report.gitRevision_ = ctx->string("git_revision");
+            report.cpuModel_    = ctx->string("cpu_model");
+            report.date_        = ctx->string("date");
+            report.buildType_   = ctx->string("library_build_type");
+        }
+        importGoogleBenchmark(doc, report);
+        return report;
+    }
+
+    report.benchmark_   = doc.string("benchmark");
+    report.gitRevision_ = doc.string("git_revision");
+    report.cpuModel_    = doc.string("cpu_model");
+    report.date_        = doc.string("date");
+    report.buildType_   = doc.string("build_type");
+    if (const Json* params = doc.get("params"))
+        for (size_t i = 0; i < params->keys.size(); ++i)
+            report.setParam(params->keys[i], params->items[i].text);
+
+    const Json* metrics = doc.get("metrics");
+    if (!metrics || metrics->type != Json::Array)
+        throw std::runtime_error("Rapport de bench invalide : tableau « metrics » absent");
+    for (const Json& m : metrics->items) {
+        Metric metric{ m.string("name"), m.string("unit"), m.string("better") != "lower", {} };
+        if (const Json* samples = m.get("samples"))
+            for (const Json& s : samples->items)
+                if (s.type == Json::Number) metric.samples.push_back(s.number);
+        report.metrics_.push_back(std::move(metric));
+    }
+    return report;
+}
+
+std::string BenchReport::currentGitRevision() {
+    return ME_GIT_REVISION;
+}
+
+std::string BenchReport::currentCpuModel() {
+    std::ifstream in("/proc/cpuinfo");
+    std::string   line;
+    while (std::getline(in, line)) {
+        if (line.compare(0, 10, "model name") != 0)
+            continue;
+        auto colon = line.find(':');
+        auto first = line.find_first_not_of(" \t", colon + 1);
+        return first == std::string::npos ? std::string() : line.substr(first);
+    }
+    return "inconnu";
+}
+
+MetricComparison compareMetric(const BenchReport::Metric& base,
+                               const BenchReport::Metric& cand, double threshold) {
+    MetricComparison c;
+    if (base.samples.empty() || cand.samples.empty())
+        return c;
+
+    double baseVar, candVar;
+    meanVariance(base.samples, c.baseMean, baseVar);
+    meanVariance(cand.samples, c.candMean, candVar);
+    double scale = std::fabs(c.baseMean);
+    double diff  = c.candMean - c.baseMean;
+    c.change = scale > 0 ? diff / scale : 0.0;
+
+    // Référence nulle (zéro allocation…) : pas d'écart relatif, tout écart compte,
+    // même sur une seule passe
+    if (scale == 0) {
+        if (diff == 0) {
+            c.verdict = MetricComparison::Unchanged;
+            return c;
+        }
+        c.change  = c.ciLow = c.ciHigh = std::copysign(HUGE_VAL, diff);
+        c.verdict = (diff > 0) == cand.higherIsBetter ? MetricComparison::Improvement
+                                                      : MetricComparison::Regression;
+        return c;
+    }
+
+    double nb = static_cast<double>(base.samples.size());
+    double nc = static_cast<double>(cand.samples.size());
+    if (nb < 2 || nc < 2) {
+        c.ciLow = c.ciHigh = c.change;
+        return c;
+    }
+
+    // Métrique déterministe (variance nulle des deux côtés) : comparaison exacte
+    if (baseVar == 0 && candVar == 0) {
+        c.ciLow = c.ciHigh = c.change;
+        if (std::fabs(c.change) <= threshold)
+            c.verdict = MetricComparison::Unchanged;
+        else
+            c.verdict = (diff > 0) == cand.higherIsBetter ? MetricComparison::Improvement
+                                                          : MetricComparison::Regression;
+        return c;
+    }
+
+    // Welch : variances inégales, degrés de liberté de Welch–Satterthwaite
+    double vb = baseVar / nb, vc = candVar / nc;
+    double se = std::sqrt(vb + vc);
+    double df = se > 0 ? (vb + vc) * (vb + vc) / (vb * vb / (nb - 1) + vc * vc / (nc - 1)) : 1e9;
+    double margin = studentT975(df) * se / scale;
+    c.ciLow  = c.change - margin;
+    c.ciHigh = c.change + margin;
+
+    bool significant = (c.ciLow > 0 || c.ciHigh < 0) && std::fabs(c.change) > threshold;
+    if (!significant)
+        c.verdict = MetricComparison::Unchanged;
+    else if ((diff > 0) == cand.higherIsBetter)
+        c.verdict = MetricComparison::Improvement;
+    else
+        c.verdict = MetricComparison::Regression;
+    return c;
+}
+
+const char* toString(MetricComparison::Verdict v) {
+    switch (v) {
+        case MetricComparison::Unchanged:    return "=";
+        case MetricComparison::Improvement:  return "mieux";
+        case MetricComparison::Regression:   return "RÉGRESSION";
+        case MetricComparison::Inconclusive: return "?";
+    }
+    return "?";
+}
+
+} // namespace me
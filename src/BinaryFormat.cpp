@@ -0,0 +1,100 @@
+#include "BinaryFormat.h"
+#include <stdexcept>
+
+namespace me::binfmt {
+
+namespace {
+    Symbol symbolAt(const std::vector<Symbol>& symbols, uint32_t id) {
+        if (id >= symbols.size())
+            throw std::runtime_error("Enregistrement binaire invalide : symbole " + std::to_string(id));
+        return symbols[id];
+    }
+
+    template<typename E>
+    E enumAt(unsigned char b, E last) {
+        if (b > static_cast<unsigned char>(last))
+            throw std::runtime_error("Enregistrement binaire invalide : octet d'enum " + std::to_string(b));
+        return static_cast<E>(b);
+    }
+}
+
+void encodeHeader(unsigned char* p, const Header& h) {
+    std::memcpy(p, h.magic, 4);
+    store<uint16_t>(p + 4,  h.version);
+    store<uint16_t>(p + 6,  h.recordSize);
+    store<uint32_t>(p + 8,  h.symbolCount);
+    store<uint32_t>(p + 12, h.priceDecimals);
+    store<uint64_t>(p + 16, h.recordCount);
+    store<uint64_t>(p + 24, h.dictOffset);
+}
+
+Header decodeHeader(const unsigned char* p) {
+    Header h{};
+    std::memcpy(h.magic, p, 4);
+    h.version       = load<uint16_t>(p + 4);
+    h.recordSize    = load<uint16_t>(p + 6);
+    h.symbolCount   = load<uint32_t>(p + 8);
+    h.priceDecimals = load<uint32_t>(p + 12);
+    h.recordCount   = load<uint64_t>(p + 16);
+    h.dictOffset    = load<uint64_t>(p + 24);
+    return h;
+}
+
+void encodeOrder(unsigned char* p, const Order& o, uint32_t symbol, const TickScale& scale) {
+    store<uint64_t>(p,      o.timestamp);
+    store<uint64_t>(p + 8,  o.order_id);
+    store<int64_t> (p + 16, scale.toTicks(o.price));
+    store<uint64_t>(p + 24, o.quantity);
+    store<uint32_t>(p + 32, symbol);
+    p[36] = static_cast<unsigned char>(o.side);
+    p[37] = static_cast<unsigned char>(o.type);
+    p[38] = static_cast<unsigned char>(o.action);
+    p[39] = 0;
+}
+
+Order decodeOrder(const unsigned char* p, const std::vector<Symbol>& symbols, const TickScale& scale) {
+    Order o;
+    o.timestamp  = load<uint64_t>(p);
+    o.order_id   = load<uint64_t>(p + 8);
+    o.price      = scale.toPrice(load<int64_t>(p + 16));
+    o.quantity   = load<uint64_t>(p + 24);
+    o.instrument = symbolAt(symbols, load<uint32_t>(p + 32));
+    o.side       = enumAt(p[36], Side::SELL);
+    o.type       = enumAt(p[37], Type::MARKET);
+    o.action     = enumAt(p[38], Action::CANCEL);
+    return o;
+}
+
+void encodeResult(unsigned char* p, const MatchResult& r, uint32_t symbol, const TickScale& scale) {
+    store<uint64_t>(p,      r.timestamp);
+    store<uint64_t>(p + 8,  r.order_id);
+    store<uint64_t>(p + 16, r.quantity);
+    store<int64_t> (p + 24, scale.toTicks(r.price));
+    store<uint64_t>(p + 32, r.executed_quantity);
+    store<int64_t> (p + 40, scale.toTicks(r.execution_price));
+    store<uint64_t>(p + 48, r.counterparty_id);
+    store<uint32_t>(p + 56, symbol);
+    p[60] = static_cast<unsigned char>(r.side);
+    p[61] = static_cast<unsigned char>(r.type);
+    p[62] = static_cast<unsigned char>(r.action);
+    p[63] = static_cast<unsigned char>(r.status);
+}
+
+MatchResult decodeResult(const unsigned char* p, const std::vector<Symbol>& symbols, const TickScale& scale) {
+    MatchResult r;
+    r.timestamp         = load<uint64_t>(p);
+    r.order_id          = load<uint64_t>(p + 8);
+    r.quantity          = load<uint64_t>(p + 16);
+    r.price             = scale.toPrice(load<int64_t>(p + 24));
+    r.executed_quantity = load<uint64_t>(p + 32);
+    r.execution_price   = scale.toPrice(load<int64_t>(p + 40));
+    r.counterparty_id   = load<uint64_t>(p + 48);
+    r.instrument        = symbolAt(symbols, load<uint32_t>(p + 56));
+    r.side              = enumAt(p[60], Side::SELL);
+    r.type              = enumAt(p[61], Type::MARKET);
+    r.action            = enumAt(p[62], Action::CANCEL);
+    r.status            = enumAt(p[63], Status::REJECTED);
+    return r;
+}
+
+} // namespace me::binfmt
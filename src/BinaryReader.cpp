@@ -0,0 +1,60 @@
+#include "BinaryReader.h"
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+
+namespace me {
+
+namespace {
+    bool hasMagic(const std::string& filename, const char (&magic)[4]) {
+        std::ifstream in(filename, std::ios::binary);
+        char head[4];
+        return in.read(head, 4) && std::memcmp(head, magic, 4) == 0;
+    }
+}
+
+bool isBinaryOrderFile(const std::string& filename)  { return hasMagic(filename, binfmt::kOrderMagic); }
+bool isBinaryResultFile(const std::string& filename) { return hasMagic(filename, binfmt::kResultMagic); }
+
+BinaryReader::BinaryReader(const std::string& filename, const char (&magic)[4], size_t recordSize)
+  : file_(filename)
+{
+    auto invalid = [&](const std::string& why) {
+        return std::runtime_error("Fichier binaire « " + filename + " » invalide : " + why);
+    };
+
+    base_       = reinterpret_cast<const unsigned char*>(file_.data());
+    size_t size = file_.size();
+    if (size < binfmt::kHeaderSize)
+        throw invalid("en-tête tronqué");
+    header_ = binfmt::decodeHeader(base_);
+    if (std::memcmp(header_.magic, magic, 4) != 0)
+        throw invalid("signature inattendue");
+    if (header_.version != binfmt::kVersion)
+        throw invalid("version " + std::to_string(header_.version) + " non supportée");
+    if (header_.recordSize != recordSize)
+        throw invalid("taille d'enregistrement " + std::to_string(header_.recordSize));
+    if (header_.priceDecimals > 18)
+        throw invalid("précision des prix " + std::to_string(header_.priceDecimals));
+    if (header_.recordCount > (size - binfmt::kHeaderSize) / recordSize
+        || header_.dictOffset != binfmt::kHeaderSize + header_.recordCount * recordSize)
+        throw invalid("enregistrements tronqués (fichier non fermé ?)");
+
+    scale_ = TickScale(std::pow(10.0, -static_cast<double>(header_.priceDecimals)));
+
+    // dictionnaire : longueur u16 + nom, dans l'ordre des ids du fichier
+    size_t pos = static_cast<size_t>(header_.dictOffset);
+    symbols_.reserve(header_.symbolCount);
+    for (uint32_t i = 0; i < header_.symbolCount; ++i) {
+        if (pos + 2 > size)
+            throw invalid("dictionnaire tronqué");
+        size_t len = binfmt::load<uint16_t>(base_ + pos);
+        pos += 2;
+        if (pos + len > size)
+            throw invalid("dictionnaire tronqué");
+        symbols_.emplace_back(std::string_view(file_.data() + pos, len));
+        pos += len;
+    }
+}
+
+} // namespace me
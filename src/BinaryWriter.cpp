@@ -0,0 +1,65 @@
+#include "BinaryWriter.h"
+#include "Logger.h"
+#include <stdexcept>
+
+namespace me {
+
+BinaryWriter::BinaryWriter(const std::string& filename, const char (&magic)[4], size_t recordSize,
+                           const OutputFile::Options& opts)
+  : out_(filename, opts), recordSize_(recordSize)
+{
+    std::memcpy(magic_, magic, 4);
+    // en-tête provisoire, réécrit par close()
+    out_.append(std::string(binfmt::kHeaderSize, '\0'));
+}
+
+BinaryWriter::~BinaryWriter() {
+    try {
+        close();
+    } catch (const std::exception& e) {
+        LOG_ERROR("BinaryWriter : fermeture impossible : {}", e.what());
+    }
+}
+
+uint32_t BinaryWriter::fileId(Symbol s) {
+    if (s.id() >= fileIds_.size())
+        fileIds_.resize(s.id() + 1, 0);
+    uint32_t& slot = fileIds_[s.id()];
+    if (slot == 0) {
+        symbols_.push_back(s);
+        slot = static_cast<uint32_t>(symbols_.size());
+    }
+    return slot - 1;
+}
+
+void BinaryWriter::close() {
+    if (closed_)
+        return;
+    closed_ = true;
+
+    // dictionnaire des symboles, dans l'ordre des ids du fichier
+    binfmt::Header h{};
+    std::memcpy(h.magic, magic_, 4);
+    h.version       = binfmt::kVersion;
+    h.recordSize    = static_cast<uint16_t>(recordSize_);
+    h.symbolCount   = static_cast<uint32_t>(symbols_.size());
+    h.priceDecimals = binfmt::kPriceDecimals;
+    h.recordCount   = count_;
+    h.dictOffset    = binfmt::kHeaderSize + count_ * recordSize_;
+    for (Symbol s : symbols_) {
+        const std::string& name = s.name();
+        if (name.size() > UINT16_MAX)
+            throw std::runtime_error("Nom d'instrument trop long pour le format binaire");
+        auto* len = reinterpret_cast<unsigned char*>(out_.reserve(2 + name.size()));
+        binfmt::store<uint16_t>(len, static_cast<uint16_t>(name.size()));
+        out_.commit(reinterpret_cast<char*>(len) + 2);
+        out_.append(name);
+    }
+
+    unsigned char header[binfmt::kHeaderSize];
+    binfmt::encodeHeader(header, h);
+    out_.writeAt(0, header, sizeof(header));
+    out_.close();
+}
+
+} // namespace me
@@ -1,142 +1,240 @@
 #include "CsvParser.h"
 #include "Logger.h"
-#include <sstream>    // std::stringstream
+#include <charconv>   // std::from_chars
+#include <cmath>      // std::isfinite
+#include <cstring>    // std::memchr
 #include <string>
 #include <vector>
 #include <stdexcept>
-#include <utility>    // std::move
 #include <optional>
 
 
 namespace me {
 
-CsvParser::CsvParser(std::string const& filename)
-  : in_(filename), lineNumber_(0)
+namespace {
+    constexpr size_t kColumns = CsvParser::kColumns;
+
+    // Découpe la ligne sur ',' sans copie. Même convention que l'ancien découpage
+    // par std::getline : une ligne vide n'a aucun champ et une virgule finale
+    // n'ouvre pas de champ vide. Renvoie le nombre de champs (au plus kColumns + 1).
+    size_t splitFields(std::string_view line, CsvParser::Fields& fields) {
+        size_t      n   = 0;
+        const char* p   = line.data();
+        const char* end = p + line.size();
+        while (p != end && n <= kColumns) {
+            auto* comma = static_cast<const char*>(std::memchr(p, ',', static_cast<size_t>(end - p)));
+            const char* stop = comma ? comma : end;
+            fields[n++] = { p, static_cast<size_t>(stop - p) };
+            p = comma ? comma + 1 : end;
+        }
+        return n;
+    }
+
+    // Champ numérique sans ses blancs de tête et de queue, que std::stoull / std::stod
+    // ignoraient déjà (" 10", "100.5 ")
+    std::string_view trimmed(std::string_view s) {
+        auto blank = [](char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f'; };
+        while (!s.empty() && blank(s.front())) s.remove_prefix(1);
+        while (!s.empty() && blank(s.back()))  s.remove_suffix(1);
+        return s;
+    }
+
+    // Signe '+' explicite, accepté par std::stoull / std::stod mais pas par from_chars
+    std::string_view withoutPlus(std::string_view s) {
+        if (s.size() > 1 && s.front() == '+' && s[1] != '+' && s[1] != '-')
+            s.remove_prefix(1);
+        return s;
+    }
+
+    // Entier non signé occupant tout le champ (blancs autour et '+' tolérés)
+    bool parseUnsigned(std::string_view s, uint64_t& out) {
+        s = withoutPlus(trimmed(s));
+        auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), out);
+        return ec == std::errc{} && ptr == s.data() + s.size();
+    }
+
+    // Décimal fini occupant tout le champ (blancs autour et '+' tolérés)
+    bool parsePrice(std::string_view s, double& out) {
+        s = withoutPlus(trimmed(s));
+        auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), out);
+        return ec == std::errc{} && ptr == s.data() + s.size() && std::isfinite(out);
+    }
+
+    std::nullopt_t reject(std::vector<ParseError>& errors, size_t lineNumber,
+                          std::string_view line, const char* message) {
+        errors.push_back({ lineNumber, message, std::string(line) });
+        return std::nullopt;
+    }
+}
+
+void logParseError(ParseError const& e) {
+    LOG_WARN("Ligne {} : {}: \"{}\"", e.line_number, e.message, e.raw_line);
+}
+
+CsvParser::CsvParser(std::string const& filename, Source source)
+  : source_(source), lineNumber_(0)
 {
-    if (!in_.is_open())
-        throw std::runtime_error("Impossible d'ouvrir « " + filename + " »");
+    if (source_ == Source::Mapped) {
+        file_    = MappedFile(filename);
+        scanner_ = CsvScanner(file_.view());
+    }
+    else {
+        in_.open(filename);
+        if (!in_.is_open())
+            throw std::runtime_error("Impossible d'ouvrir « " + filename + " »");
+    }
 
     // On saute l'en-tête (timestamp,order_id,…) pour que next() ne le parse jamais
-    std::string header;
-    if (std::getline(in_, header))
+    std::string_view header;
+    Fields           fields;
+    size_t           count;
+    if (readLine(header, fields, count))
         ++lineNumber_;
 }
 
-std::vector<std::string> CsvParser::split(std::string const& s, char delim) {
-    std::vector<std::string> elems;
-    std::stringstream ss{s};
-    std::string item;
-    while (std::getline(ss, item, delim))
-        elems.push_back(std::move(item));
-    return elems;
+bool CsvParser::scanLine(std::string_view text, CsvScanner& scanner, size_t& pos,
+                         std::string_view& line, Fields& fields, size_t& count) {
+    // même découpage que std::getline : la dernière ligne peut ne pas finir par '\n'
+    const char* data = text.data();
+    size_t      size = text.size();
+    if (pos >= size)
+        return false;
+
+    size_t start = pos, fieldStart = pos, end;
+    count = 0;
+    while (true) {
+        size_t d = scanner.next();
+        if (d >= size || data[d] == '\n') {
+            end = d < size ? d : size;
+            break;
+        }
+        if (count <= kColumns)           // au-delà, seul le dépassement compte
+            fields[count++] = { data + fieldStart, d - fieldStart };
+        fieldStart = d + 1;
+    }
+    // une virgule finale n'ouvre pas de champ vide (comme std::getline)
+    if (end > fieldStart && count <= kColumns)
+        fields[count++] = { data + fieldStart, end - fieldStart };
+
+    line = { data + start, end - start };
+    pos  = end + 1;
+    return true;
+}
+
+size_t CsvParser::parseChunk(std::string_view text, std::vector<Order>& orders,
+                             std::vector<ParseError>& errors) {
+    CsvScanner       scanner(text);
+    size_t           pos   = 0;
+    size_t           lines = 0;
+    std::string_view line;
+    Fields           fields;
+    size_t           count;
+    while (scanLine(text, scanner, pos, line, fields, count)) {
+        if (auto o = parseFields(line, fields, count, ++lines, errors))
+            orders.push_back(*o);
+    }
+    return lines;
+}
+
+bool CsvParser::readLine(std::string_view& line, Fields& fields, size_t& count) {
+    if (source_ == Source::Stream) {
+        if (!std::getline(in_, buffer_))
+            return false;
+        line  = buffer_;
+        count = splitFields(line, fields);
+        return true;
+    }
+
+    return scanLine(file_.view(), scanner_, pos_, line, fields, count);
 }
 
 std::optional<Order> CsvParser::next() {
-    std::string line;
-    if (!std::getline(in_, line))
+    std::string_view line;
+    Fields           fields;
+    size_t           count;
+    if (!readLine(line, fields, count))
         return std::nullopt;
 
     ++lineNumber_;
-    auto fields = split(line, ',');
-    if (fields.size() != 8) {
-        errors_.push_back({ lineNumber_, "Nombre de colonnes != 8", line });
-        LOG_WARN("Nombre de colonnes invalide: \"" + line + "\"");
-        return std::nullopt;
-    }
+    auto o = parseFields(line, fields, count, lineNumber_, errors_);
+    if (!o)
+        logParseError(errors_.back());
+    return o;
+}
+
+std::optional<Order> CsvParser::parseLine(std::string_view line, size_t lineNumber,
+                                          std::vector<ParseError>& errors) {
+    Fields fields;
+    size_t count = splitFields(line, fields);
+    auto   o     = parseFields(line, fields, count, lineNumber, errors);
+    if (!o)
+        logParseError(errors.back());
+    return o;
+}
+
+std::optional<Order> CsvParser::parseFields(std::string_view line, Fields const& fields, size_t count,
+                                            size_t lineNumber, std::vector<ParseError>& errors) {
+    if (count != kColumns)
+        return reject(errors, lineNumber, line, "Nombre de colonnes != 8");
 
     // 1) timestamp
     uint64_t ts;
-    try {
-        ts = std::stoull(fields.at(0));
-    } catch (...) {
-        errors_.push_back({ lineNumber_, "Timestamp invalide", line });
-        LOG_WARN("Timestamp invalide: \"" + line + "\"");
-        return std::nullopt;
-    }
+    if (!parseUnsigned(fields[0], ts))
+        return reject(errors, lineNumber, line, "Timestamp invalide");
 
     // 2) order_id
     uint64_t id;
-    try {
-        id = std::stoull(fields.at(1));
-    } catch (...) {
-        errors_.push_back({ lineNumber_, "order_id invalide", line });
-        LOG_WARN("order_id invalide: \"" + line + "\"");
-        return std::nullopt;
-    }
+    if (!parseUnsigned(fields[1], id))
+        return reject(errors, lineNumber, line, "order_id invalide");
 
     // 3) instrument
-    auto const& instr = fields.at(2);
-    if (instr.empty()) {
-        errors_.push_back({ lineNumber_, "Instrument vide", line });
-        LOG_WARN("Instrument invalide: \"" + line + "\"");
-        return std::nullopt;
-    }
+    std::string_view instr = fields[2];
+    if (instr.empty())
+        return reject(errors, lineNumber, line, "Instrument vide");
 
     // 4) side
     Side side;
     try {
-         side = sideFromString(fields.at(3));
+         side = sideFromString(fields[3]);
     } catch (...) {
-        errors_.push_back({ lineNumber_, "Side invalide", line });
-        LOG_WARN("Side invalide: \"" + line + "\"");
-        return std::nullopt;
+        return reject(errors, lineNumber, line, "Side invalide");
     }
 
     // 5) type
     Type type;
     try {
-        type = typeFromString(fields.at(4));
+        type = typeFromString(fields[4]);
     } catch (...) {
-        errors_.push_back({ lineNumber_, "Type invalide", line });
-        LOG_WARN("Type invalide: \"" + line + "\"");
-        return std::nullopt;
+        return reject(errors, lineNumber, line, "Type invalide");
     }
 
     // 8) action
     Action action;
     try {
-        action = actionFromString(fields.at(7));
+        action = actionFromString(fields[7]);
     } catch (...) {
-        errors_.push_back({ lineNumber_, "Action invalide", line });
-        LOG_WARN("Action invalide: \"" + line + "\"");
-        return std::nullopt;
+        return reject(errors, lineNumber, line, "Action invalide");
     }
 
     // 9) quantity
-    auto const& qtyStr = fields.at(5);
+    std::string_view qtyStr = trimmed(fields[5]);
     // si on avait un signe moins en tête, on rejette
-    if (qtyStr.size() > 1 && qtyStr.front() == '-') {
-        errors_.push_back({ lineNumber_, "Quantité négative", line });
-        LOG_WARN("Quantité négative: \"" + line + "\"");
-        return std::nullopt;
-    }
+    if (qtyStr.size() > 1 && qtyStr.front() == '-')
+        return reject(errors, lineNumber, line, "Quantité négative");
     uint64_t qty;
-    try {
-        qty = std::stoull(qtyStr);
-    } catch (...) {
-        errors_.push_back({ lineNumber_, "Quantité invalide", line });
-        LOG_WARN("Quantité invalide: \"" + line + "\"");
-        return std::nullopt;
-    }
+    if (!parseUnsigned(qtyStr, qty))
+        return reject(errors, lineNumber, line, "Quantité invalide");
 
     // 10) price
     double price = 0.0;
     if (type == Type::LIMIT) { // si c’est un ordre LIMIT, on attend un prix, pas pour un MARKET
-        auto const& priceStr = fields.at(6);
+        std::string_view priceStr = trimmed(fields[6]);
         // négatif ?
-        if (!priceStr.empty() && priceStr.front() == '-') {
-            errors_.push_back({ lineNumber_, "Prix négatif", line });
-            LOG_WARN("Prix négatif: \"" + line + "\"");
-            return std::nullopt;
-        }
+        if (!priceStr.empty() && priceStr.front() == '-')
+            return reject(errors, lineNumber, line, "Prix négatif");
         // conversion
-        try {
-            price = std::stod(priceStr);
-        } catch (...) {
-            errors_.push_back({ lineNumber_, "Prix invalide", line });
-            LOG_WARN("Prix invalide: \"" + line + "\"");
-            return std::nullopt;
-        }
+        if (!parsePrice(priceStr, price))
+            return reject(errors, lineNumber, line, "Prix invalide");
     }
 
     // 11) création de l’ordre (limit ou market)
@@ -144,7 +242,7 @@ std::optional<Order> CsvParser::next() {
       ? Order::makeLimit (ts, id, instr, side, qty, price, action)
       : Order::makeMarket(ts, id, instr, side, qty, action);
 
-    return std::make_optional(std::move(o));
+    return o;
 }
 
 } // namespace me
@@ -0,0 +1,129 @@
+#include "CsvScanner.h"
+#include <cstring>
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define ME_X86_64 1
+#endif
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace me {
+
+namespace {
+
+    uint64_t scalarMask(const char* b) {
+        uint64_t m = 0;
+        for (unsigned i = 0; i < CsvScanner::kBlock; ++i)
+            m |= static_cast<uint64_t>(b[i] == ',' || b[i] == '\n') << i;
+        return m;
+    }
+
+#if defined(ME_X86_64)
+    // SSE2 fait partie de l'ABI x86-64 : toujours disponible
+    uint64_t sse2Mask(const char* b) {
+        const __m128i comma = _mm_set1_epi8(',');
+        const __m128i nl    = _mm_set1_epi8('\n');
+        uint64_t m = 0;
+        for (unsigned i = 0; i < 4; ++i) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + 16 * i));
+            __m128i d = _mm_or_si128(_mm_cmpeq_epi8(v, comma), _mm_cmpeq_epi8(v, nl));
+            m |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(d))) << (16 * i);
+        }
+        return m;
+    }
+
+#if defined(__GNUC__) || defined(__clang__)
+    // Compilé pour AVX2 quelle que soit la cible globale ; appelé seulement si le CPU le supporte
+    __attribute__((target("avx2")))
+    uint64_t avx2Mask(const char* b) {
+        const __m256i comma = _mm256_set1_epi8(',');
+        const __m256i nl    = _mm256_set1_epi8('\n');
+        __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b));
+        __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + 32));
+        __m256i dl = _mm256_or_si256(_mm256_cmpeq_epi8(lo, comma), _mm256_cmpeq_epi8(lo, nl));
+        __m256i dh = _mm256_or_si256(_mm256_cmpeq_epi8(hi, comma), _mm256_cmpeq_epi8(hi, nl));
+        return static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(dl)))
+             | static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(dh))) << 32;
+    }
+#define ME_HAS_AVX2_KERNEL 1
+#endif
+#endif
+
+} // namespace
+
+bool CsvScanner::supported(Kernel k) {
+    switch (k) {
+        case Kernel::Scalar: return true;
+#if defined(ME_X86_64)
+        case Kernel::Sse2:   return true;
+#if defined(ME_HAS_AVX2_KERNEL)
+        case Kernel::Avx2:   return __builtin_cpu_supports("avx2") != 0;
+#endif
+#endif
+        default:             return false;
+    }
+}
+
+CsvScanner::Kernel CsvScanner::bestKernel() {
+    static const Kernel best = supported(Kernel::Avx2) ? Kernel::Avx2
+                             : supported(Kernel::Sse2) ? Kernel::Sse2
+                             : Kernel::Scalar;
+    return best;
+}
+
+const char* CsvScanner::name(Kernel k) {
+    switch (k) {
+        case Kernel::Scalar: return "scalar";
+        case Kernel::Sse2:   return "sse2";
+        case Kernel::Avx2:   return "avx2";
+    }
+    return "?";
+}
+
+CsvScanner::MaskFn CsvScanner::select(Kernel k) {
+    if (!supported(k))
+        return scalarMask;
+    switch (k) {
+#if defined(ME_X86_64)
+        case Kernel::Sse2: return sse2Mask;
+#if defined(ME_HAS_AVX2_KERNEL)
+        case Kernel::Avx2: return avx2Mask;
+#endif
+#endif
+        default:           return scalarMask;
+    }
+}
+
+uint64_t CsvScanner::delimiterMask(const char* block, Kernel k) {
+    return select(k)(block);
+}
+
+CsvScanner::CsvScanner(std::string_view text, Kernel k)
+  : text_(text), kernel_(supported(k) ? k : Kernel::Scalar), fn_(select(kernel_))
+{
+    seek(0);
+}
+
+void CsvScanner::seek(size_t pos) {
+    block_ = pos & ~(kBlock - 1);
+    mask_  = 0;
+    if (block_ >= text_.size())
+        return;
+    load();
+    mask_ &= ~((uint64_t{1} << (pos - block_)) - 1);   // ignore ce qui précède pos
+}
+
+void CsvScanner::load() {
+    size_t left = text_.size() - block_;
+    if (left >= kBlock) {
+        mask_ = fn_(text_.data() + block_);
+        return;
+    }
+    // dernier bloc incomplet : copié dans un tampon complété par des zéros
+    alignas(kBlock) char tail[kBlock] = {};
+    std::memcpy(tail, text_.data() + block_, left);
+    mask_ = fn_(tail);
+}
+
+} // namespace me
@@ -1,40 +1,63 @@
 #include "CsvWriter.h"
+#include "CsvFormat.h"
 #include "MatchResult.h"
-#include <iomanip>
 
 namespace me {
 
-    CsvWriter::CsvWriter(const std::string& filename)
-      : out_(filename, std::ios::trunc)
+    CsvWriter::CsvWriter(const std::string& filename, const OutputFile::Options& opts)
+      : out_(filename, opts)
     {
-        if (!out_.is_open())
-            throw std::runtime_error("Impossible d'ouvrir « " + filename + " »");
         writeHeader();
     }
 
     void CsvWriter::writeHeader() {
-        out_ << "timestamp,order_id,instrument,side,type,quantity,price,action";
-        out_ << ",status,executed_quantity,execution_price,counterparty_id\n";
+        out_.append("timestamp,order_id,instrument,side,type,quantity,price,action");
+        out_.append(",status,executed_quantity,execution_price,counterparty_id\n");
     }
 
     void CsvWriter::writeOrder(const Order& /*o_unused*/,
         const std::vector<MatchResult>& results)
     {
-        for (auto const& r : results) {
-            out_ << r.timestamp           << ','
-                 << r.order_id            << ','
-                 << r.instrument         << ','
-                 << toString(r.side)     << ','
-                 << toString(r.type)     << ','
-                 << r.quantity           << ','
-                 << r.price              << ','
-                 << toString(r.action)   << ','
-                 << toString(r.status)   << ','
-                 << r.executed_quantity  << ','
-                 << r.execution_price    << ','
-                 << r.counterparty_id
-                 << '\n';
-        }
+        for (auto const& r : results)
+            write(r);
+    }
+
+    void CsvWriter::write(const MatchResult& r) {
+        const std::string& instrument = r.instrument.name();
+        char* p = out_.reserve(csv::kMaxRow + instrument.size());
+        p = csv::put(p, r.timestamp);                 *p++ = ',';
+        p = csv::put(p, r.order_id);                  *p++ = ',';
+        p = csv::put(p, instrument);                  *p++ = ',';
+        p = csv::put(p, csv::name(r.side));           *p++ = ',';
+        p = csv::put(p, csv::name(r.type));           *p++ = ',';
+        p = csv::put(p, r.quantity);                  *p++ = ',';
+        p = csv::putPrice(p, r.price);                *p++ = ',';
+        p = csv::put(p, csv::name(r.action));         *p++ = ',';
+        p = csv::put(p, csv::name(r.status));         *p++ = ',';
+        p = csv::put(p, r.executed_quantity);         *p++ = ',';
+        p = csv::putPrice(p, r.execution_price);      *p++ = ',';
+        p = csv::put(p, r.counterparty_id);           *p++ = '\n';
+        out_.commit(p);
+    }
+
+    CsvOrderWriter::CsvOrderWriter(const std::string& filename, const OutputFile::Options& opts)
+      : out_(filename, opts)
+    {
+        out_.append("timestamp,order_id,instrument,side,type,quantity,price,action\n");
+    }
+
+    void CsvOrderWriter::write(const Order& o) {
+        const std::string& instrument = o.instrument.name();
+        char* p = out_.reserve(csv::kMaxRow + instrument.size());
+        p = csv::put(p, o.timestamp);                 *p++ = ',';
+        p = csv::put(p, o.order_id);                  *p++ = ',';
+        p = csv::put(p, instrument);                  *p++ = ',';
+        p = csv::put(p, csv::name(o.side));           *p++ = ',';
+        p = csv::put(p, csv::name(o.type));           *p++ = ',';
+        p = csv::put(p, o.quantity);                  *p++ = ',';
+        p = csv::putPrice(p, o.price);                *p++ = ',';
+        p = csv::put(p, csv::name(o.action));         *p++ = '\n';
+        out_.commit(p);
     }
 
 } // namespace me
@@ -0,0 +1,420 @@
+#include "Journal.h"
+#include "Logger.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ME_HAS_MMAP 1
+#endif
+
+namespace fs = std::filesystem;
+
+namespace me {
+
+namespace {
+    constexpr char     kMagic[4]      = { 'M', 'E', 'J', 'L' };
+    constexpr uint16_t kVersion       = 1;
+    constexpr size_t   kHeaderSize    = Journal::kRecordSize;
+    constexpr size_t   kMaxSymbolName = Journal::kRecordSize - 18;
+
+    std::string segmentName(size_t index) {
+        char buf[32];
+        std::snprintf(buf, sizeof buf, "segment-%08zu.mej", index);
+        return buf;
+    }
+
+    // Segments du répertoire, dans l'ordre des index
+    std::vector<std::pair<size_t, fs::path>> listSegments(const std::string& dir) {
+        std::vector<std::pair<size_t, fs::path>> out;
+        for (const auto& entry : fs::directory_iterator(dir)) {
+            std::string name = entry.path().filename().string();
+            if (name.size() != 20 || name.compare(0, 8, "segment-") != 0 || name.compare(16, 4, ".mej") != 0
+                || !std::all_of(name.begin() + 8, name.begin() + 16, [](char c) { return c >= '0' && c <= '9'; }))
+                continue;
+            size_t index = std::stoul(name.substr(8, 8));
+            out.emplace_back(index, entry.path());
+        }
+        std::sort(out.begin(), out.end());
+        return out;
+    }
+
+    // Somme de contrôle des octets 0..3 et 8..63 (la somme elle-même, en 4..7, est exclue)
+    uint32_t checksum(const unsigned char* p) {
+        uint64_t h = 0xcbf29ce484222325ull;
+        for (size_t i = 0; i < Journal::kRecordSize; i += 8) {
+            uint64_t w = binfmt::load<uint64_t>(p + i);
+            if (i == 0) w &= 0xffffffffull;
+            h  = (h ^ w) * 0x9e3779b97f4a7c15ull;
+            h ^= h >> 29;
+        }
+        return static_cast<uint32_t>(h ^ (h >> 32));
+    }
+
+    bool validRecord(const unsigned char* p) {
+        return p[0] != 0 && binfmt::load<uint32_t>(p + 4) == checksum(p);
+    }
+
+    struct SegmentHeader {
+        uint32_t index;
+        uint64_t firstSeq;
+    };
+
+    SegmentHeader decodeSegmentHeader(const unsigned char* p, size_t size, const std::string& path) {
+        if (size < kHeaderSize || std::memcmp(p, kMagic, 4) != 0)
+            throw std::runtime_error("Journal : « " + path + " » n'est pas un segment de journal");
+        if (binfmt::load<uint16_t>(p + 4) != kVersion || binfmt::load<uint16_t>(p + 6) != Journal::kRecordSize)
+            throw std::runtime_error("Journal : version ou taille d'enregistrement non supportée dans « " + path + " »");
+        return { binfmt::load<uint32_t>(p + 8), binfmt::load<uint64_t>(p + 16) };
+    }
+
+    uint64_t nowNs() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+}
+
+Journal::Journal(const std::string& dir, const Options& opts)
+  : opts_(opts), durability_(opts.durability), groupSize_(std::max<size_t>(opts.groupSize, 1)), dir_(dir)
+{
+#if defined(ME_HAS_MMAP)
+    fs::create_directories(dir_);
+    auto existing = listSegments(dir_);
+    if (existing.empty()) openSegment(0);
+    else                  recoverSegment(existing.back().first);
+
+    if (durability_ == Durability::Async)
+        syncer_ = std::thread([this] { syncLoop(); });
+#else
+    throw std::runtime_error("Journal : projection mémoire indisponible sur cette plateforme");
+#endif
+}
+
+Journal::~Journal() {
+    try {
+        close();
+    } catch (const std::exception& e) {
+        LOG_ERROR("Journal : fermeture impossible : {}", e.what());
+    }
+}
+
+void Journal::seal(unsigned char* p, unsigned char type, uint64_t key) {
+    binfmt::store<uint64_t>(p + 8, key);
+    p[0] = type;
+    binfmt::store<uint32_t>(p + 4, checksum(p));
+}
+
+uint64_t Journal::appendSlow(const Order& o) {
+    if (slotsLeft_ < 2) {
+        // segment plein : le suivant commence à nextSeq_, avec son propre dictionnaire
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (durability_ != Durability::None) {
+                syncRange(synced_, used_);
+                synced_ = used_;
+            }
+            unmapSegment();
+        }
+        openSegment(segmentIndex_ + 1);
+        pending_ = 0;
+    }
+
+    uint32_t id = fileIdFor(o.instrument);
+    if (id == kNoId) {
+        const std::string& name = o.instrument.name();
+        if (name.size() > kMaxSymbolName)
+            throw std::runtime_error("Journal : nom d'instrument trop long (" + std::to_string(kMaxSymbolName)
+                                     + " octets au plus) : " + name);
+        id = symbolCount_++;
+        unsigned char* p = cursor();
+        binfmt::store<uint16_t>(p + 16, static_cast<uint16_t>(name.size()));
+        std::memcpy(p + 18, name.data(), name.size());
+        seal(p, kSymbolRecord, id);
+        publish();
+        if (o.instrument.id() >= fileIds_.size())
+            fileIds_.resize(o.instrument.id() + 1, kNoId);
+        fileIds_[o.instrument.id()] = id;
+    }
+    return appendRecord(o, id);
+}
+
+void Journal::openSegment(size_t index) {
+#if defined(ME_HAS_MMAP)
+    std::string path = (fs::path(dir_) / segmentName(index)).string();
+    auto   page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    size_t sz   = std::max(opts_.segmentBytes, kHeaderSize + 2 * kRecordSize);
+    sz          = (sz + page - 1) / page * page;
+
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        throw std::runtime_error("Journal : impossible de créer « " + path + " »");
+    // blocs réservés dès maintenant : un ajout ne modifie jamais la taille du fichier
+#if defined(__linux__)
+    bool sized = ::posix_fallocate(fd, 0, static_cast<off_t>(sz)) == 0 || ::ftruncate(fd, static_cast<off_t>(sz)) == 0;
+#else
+    bool sized = ::ftruncate(fd, static_cast<off_t>(sz)) == 0;
+#endif
+    // pages projetées d'avance : pas de défaut de page sur le chemin d'append()
+#if defined(MAP_POPULATE)
+    int flags = MAP_SHARED | MAP_POPULATE;
+#else
+    int flags = MAP_SHARED;
+#endif
+    void* p = sized ? ::mmap(nullptr, sz, PROT_READ | PROT_WRITE, flags, fd, 0) : MAP_FAILED;
+    if (p == MAP_FAILED) {
+        ::close(fd);
+        throw std::runtime_error("Journal : préallocation ou mmap impossible sur « " + path + " »");
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    fd_           = fd;
+    base_         = static_cast<unsigned char*>(p);
+    size_         = sz;
+    segmentIndex_ = index;
+    std::memcpy(base_, kMagic, 4);
+    binfmt::store<uint16_t>(base_ + 4,  kVersion);
+    binfmt::store<uint16_t>(base_ + 6,  static_cast<uint16_t>(kRecordSize));
+    binfmt::store<uint32_t>(base_ + 8,  static_cast<uint32_t>(index));
+    binfmt::store<uint64_t>(base_ + 16, nextSeq_);
+    binfmt::store<uint64_t>(base_ + 24, sz);
+    used_        = kHeaderSize;
+    slotsLeft_   = (sz - kHeaderSize) / kRecordSize;
+    synced_      = 0;
+    symbolCount_ = 0;
+    fileIds_.assign(fileIds_.size(), kNoId);
+    written_.store(used_, std::memory_order_release);
+
+    if (durability_ != Durability::None) {
+        // en-tête, allocation des blocs et entrée de répertoire durables avant le premier ordre
+        uint64_t t0 = nowNs();
+        bool ok = ::msync(base_, page, MS_SYNC) == 0;
+#if defined(__linux__)
+        ok = ok && ::fdatasync(fd_) == 0;
+#else
+        ok = ok && ::fsync(fd_) == 0;
+#endif
+        int dirFd = ::open(dir_.c_str(), O_RDONLY);
+        if (dirFd >= 0) {
+            ok = ok && ::fsync(dirFd) == 0;
+            ::close(dirFd);
+        }
+        syncs_.fetch_add(1, std::memory_order_relaxed);
+        syncNs_.fetch_add(nowNs() - t0, std::memory_order_relaxed);
+        if (!ok)
+            throw std::runtime_error("Journal : synchronisation impossible de « " + path + " »");
+        synced_ = used_;
+    }
+#else
+    (void)index;
+#endif
+}
+
+void Journal::recoverSegment(size_t index) {
+#if defined(ME_HAS_MMAP)
+    std::string path = (fs::path(dir_) / segmentName(index)).string();
+    int fd = ::open(path.c_str(), O_RDWR);
+    struct stat st {};
+    if (fd < 0 || ::fstat(fd, &st) != 0) {
+        if (fd >= 0) ::close(fd);
+        throw std::runtime_error("Journal : impossible d'ouvrir « " + path + " »");
+    }
+    size_t sz = static_cast<size_t>(st.st_size);
+    void*  p  = sz >= kHeaderSize ? ::mmap(nullptr, sz, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    if (p == MAP_FAILED) {
+        ::close(fd);
+        throw std::runtime_error("Journal : segment illisible « " + path + " »");
+    }
+    fd_           = fd;
+    base_         = static_cast<unsigned char*>(p);
+    size_         = sz;
+    segmentIndex_ = index;
+    nextSeq_      = decodeSegmentHeader(base_, size_, path).firstSeq;
+
+    // dernier enregistrement valide ; dictionnaire du segment reconstruit au passage
+    size_t pos = kHeaderSize;
+    fileIds_.clear();
+    symbolCount_ = 0;
+    for (; pos + kRecordSize <= size_ && validRecord(base_ + pos); pos += kRecordSize) {
+        const unsigned char* r   = base_ + pos;
+        uint64_t             key = binfmt::load<uint64_t>(r + 8);
+        if (r[0] == kSymbolRecord) {
+            auto   len = std::min<size_t>(binfmt::load<uint16_t>(r + 16), kMaxSymbolName);
+            Symbol s(std::string_view(reinterpret_cast<const char*>(r + 18), len));
+            if (s.id() >= fileIds_.size())
+                fileIds_.resize(s.id() + 1, kNoId);
+            fileIds_[s.id()] = static_cast<uint32_t>(key);
+            symbolCount_     = std::max(symbolCount_, static_cast<uint32_t>(key) + 1);
+        }
+        else {
+            nextSeq_ = key + 1;
+        }
+    }
+    // fin interrompue : les restes au-delà sont effacés, pour qu'un ancien
+    // enregistrement ne soit jamais pris pour la suite du journal. Tout le reste du
+    // segment est parcouru, pas seulement la suite contiguë : sans msync (none,
+    // async), une coupure peut conserver une page tardive et perdre la précédente,
+    // laissant des enregistrements valides derrière un trou.
+    size_t stale = 0, end = pos;
+    for (size_t slot = pos; slot + kRecordSize <= size_; slot += kRecordSize) {
+        if (base_[slot] == 0)
+            continue;
+        std::memset(base_ + slot, 0, kRecordSize);
+        ++stale;
+        end = slot + kRecordSize;
+    }
+    if (stale) {
+        LOG_WARN("Journal : {} enregistrement(s) invalide(s) ignoré(s) en fin de « {} »", stale, path);
+        syncRange(pos, end);
+    }
+
+    used_      = pos;
+    slotsLeft_ = (size_ - pos) / kRecordSize;
+    synced_    = used_;
+    written_.store(used_, std::memory_order_release);
+#else
+    (void)index;
+#endif
+}
+
+void Journal::unmapSegment() {
+#if defined(ME_HAS_MMAP)
+    if (!base_)
+        return;
+    ::munmap(base_, size_);
+    ::close(fd_);
+    base_ = nullptr;
+    fd_   = -1;
+#endif
+}
+
+void Journal::syncRange(size_t from, size_t to) {
+#if defined(ME_HAS_MMAP)
+    if (to <= from || !base_)
+        return;
+    static const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    size_t   start = from / page * page;
+    uint64_t t0    = nowNs();
+    int      rc    = ::msync(base_ + start, to - start, MS_SYNC);
+    syncs_.fetch_add(1, std::memory_order_relaxed);
+    syncNs_.fetch_add(nowNs() - t0, std::memory_order_relaxed);
+    if (rc != 0)
+        throw std::runtime_error("Journal : msync impossible sur le segment " + std::to_string(segmentIndex_));
+#else
+    (void)from; (void)to;
+#endif
+}
+
+void Journal::syncPending() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    syncRange(synced_, used_);
+    synced_  = used_;
+    pending_ = 0;
+}
+
+void Journal::commit() {
+    if (closed_)
+        return;
+    syncPending();
+}
+
+void Journal::syncLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stop_) {
+        wake_.wait_for(lock, std::chrono::microseconds(opts_.intervalUs));
+        size_t w = written_.load(std::memory_order_acquire);
+        if (w <= synced_)
+            continue;
+        try {
+            syncRange(synced_, w);
+            synced_ = w;
+        } catch (const std::exception& e) {
+            LOG_ERROR("Journal : {}", e.what());
+        }
+    }
+}
+
+void Journal::close() {
+    if (closed_)
+        return;
+    if (syncer_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        syncer_.join();
+    }
+    if (durability_ != Durability::None)
+        syncPending();
+    closed_ = true;
+    std::lock_guard<std::mutex> lock(mutex_);
+    unmapSegment();
+}
+
+uint64_t Journal::replay(const std::string& dir,
+                         const std::function<void(uint64_t seq, const Order&)>& handle) {
+    if (!fs::is_directory(dir))
+        return 0;
+
+    TickScale scale{ binfmt::kTickSize };
+    uint64_t  expected = 0;   // 0 : pas encore de segment lu
+    uint64_t  count    = 0;
+    for (const auto& [index, path] : listSegments(dir)) {
+        MappedFile           file(path.string());
+        const auto*          base = reinterpret_cast<const unsigned char*>(file.data());
+        SegmentHeader        h    = decodeSegmentHeader(base, file.size(), path.string());
+        if (expected != 0 && h.firstSeq != expected)
+            throw std::runtime_error("Journal : séquence rompue entre segments (attendu "
+                                     + std::to_string(expected) + ", lu " + std::to_string(h.firstSeq) + ")");
+        expected = h.firstSeq;
+
+        std::vector<Symbol> symbols;
+        for (size_t pos = kHeaderSize; pos + kRecordSize <= file.size(); pos += kRecordSize) {
+            const unsigned char* r = base + pos;
+            if (!validRecord(r))
+                break;   // fin du segment, ou écriture interrompue
+            uint64_t key = binfmt::load<uint64_t>(r + 8);
+            if (r[0] == kSymbolRecord) {
+                auto len = std::min<size_t>(binfmt::load<uint16_t>(r + 16), kMaxSymbolName);
+                if (key >= symbols.size())
+                    symbols.resize(key + 1);
+                symbols[key] = Symbol(std::string_view(reinterpret_cast<const char*>(r + 18), len));
+                continue;
+            }
+            if (key != expected)
+                throw std::runtime_error("Journal : séquence rompue dans « " + path.string() + " » (attendu "
+                                         + std::to_string(expected) + ", lu " + std::to_string(key) + ")");
+            handle(key, binfmt::decodeOrder(r + 16, symbols, scale));
+            ++expected;
+            ++count;
+        }
+    }
+    return count;
+}
+
+Journal::Durability Journal::parseDurability(const std::string& s) {
+    if (s == "none")  return Durability::None;
+    if (s == "async") return Durability::Async;
+    if (s == "group") return Durability::Group;
+    if (s == "sync")  return Durability::Sync;
+    throw std::runtime_error("Niveau de durabilité inconnu : " + s + " (none, async, group, sync)");
+}
+
+const char* toString(Journal::Durability d) {
+    switch (d) {
+        case Journal::Durability::None:  return "none";
+        case Journal::Durability::Async: return "async";
+        case Journal::Durability::Group: return "group";
+        case Journal::Durability::Sync:  return "sync";
+    }
+    return "?";
+}
+
+} // namespace me
@@ -0,0 +1,60 @@
+#include "LatencyHistogram.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+namespace me {
+
+uint64_t LatencyHistogram::highestIn(size_t index) {
+    if (index < kSub)
+        return index;
+    size_t   rel   = index - kSub;
+    unsigned shift = static_cast<unsigned>(rel / kHalf) + 1;
+    uint64_t sub   = kHalf + rel % kHalf;
+    return ((sub + 1) << shift) - 1;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i < kBuckets; ++i)
+        counts_[i] += other.counts_[i];
+    count_ += other.count_;
+    sum_   += other.sum_;
+    min_    = std::min(min_, other.min_);
+    max_    = std::max(max_, other.max_);
+}
+
+uint64_t LatencyHistogram::percentile(double p) const {
+    if (count_ == 0)
+        return 0;
+    if (p >= 100.0)
+        return max_;
+    // rang de la mesure visée (1-indexé), au moins la première
+    auto rank = static_cast<uint64_t>(std::ceil(p / 100.0 * static_cast<double>(count_)));
+    rank = std::max<uint64_t>(rank, 1);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBuckets; ++i) {
+        seen += counts_[i];
+        if (seen >= rank)
+            return std::min(highestIn(i), max_);
+    }
+    return max_;
+}
+
+void LatencyHistogram::printHeader(std::ostream& os) {
+    os << std::setfill(' ') << std::left << std::setw(14) << "type" << std::right
+       << std::setw(10) << "n"
+       << std::setw(9) << "p50" << std::setw(9) << "p99" << std::setw(9) << "p99.9"
+       << std::setw(9) << "p99.99" << std::setw(10) << "max" << "   (ns)\n";
+}
+
+void LatencyHistogram::print(std::ostream& os, std::string_view name) const {
+    os << std::setfill(' ') << std::left << std::setw(14) << name << std::right
+       << std::setw(10) << count_
+       << std::setw(9) << percentile(50.0)
+       << std::setw(9) << percentile(99.0)
+       << std::setw(9) << percentile(99.9)
+       << std::setw(9) << percentile(99.99)
+       << std::setw(10) << max_ << '\n';
+}
+
+} // namespace me
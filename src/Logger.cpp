@@ -1,6 +1,278 @@
 #include "Logger.h"
+#include "SpscQueue.h"
+#include "Threading.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <ctime>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
 
 namespace me {
     // On l’initialise à true pour garder les logs par défaut
     std::atomic<bool> g_loggingEnabled{true};
+    std::atomic<unsigned> g_logLevels{~0u};
+
+namespace logdetail {
+
+namespace {
+
+    struct Ring {
+        explicit Ring(size_t capacity) : queue(capacity) {}
+        SpscQueue<Record> queue;
+        std::atomic<bool> retired{false};   // thread terminé : à retirer une fois vide
+    };
+
+    struct Backend {
+        std::mutex                         mutex;       // rings, démarrage / arrêt
+        std::vector<std::shared_ptr<Ring>> rings;
+        std::atomic<bool>                  running{false};
+        std::atomic<uint64_t>              generation{0};
+        size_t                             capacity = 4096;
+        std::thread                        worker;
+        std::mutex                         outMutex;    // écriture directe (mode synchrone)
+    };
+
+    // Jamais détruit : des threads peuvent encore loguer pendant la sortie du programme
+    Backend& backend() {
+        static Backend* b = new Backend;
+        return *b;
+    }
+
+    // Anneau du thread courant, marqué retiré à la fin du thread
+    struct LocalRing {
+        std::shared_ptr<Ring> ring;
+        uint64_t              generation = 0;
+        ~LocalRing() { if (ring) ring->retired.store(true, std::memory_order_release); }
+    };
+    thread_local LocalRing t_ring;
+
+    Ring* localRing(Backend& b) {
+        uint64_t gen = b.generation.load(std::memory_order_acquire);
+        if (!t_ring.ring || t_ring.generation != gen) {
+            if (t_ring.ring) t_ring.ring->retired.store(true, std::memory_order_release);
+            std::lock_guard<std::mutex> lock(b.mutex);
+            t_ring.ring       = std::make_shared<Ring>(b.capacity);
+            t_ring.generation = b.generation.load(std::memory_order_relaxed);
+            b.rings.push_back(t_ring.ring);
+        }
+        return t_ring.ring.get();
+    }
+
+    void writeNow(const Record& r) {
+        std::string line;
+        formatRecord(line, r);
+        line += '\n';
+        std::lock_guard<std::mutex> lock(backend().outMutex);
+        std::cout << line;
+    }
+
+    // « AAAA-MM-JJ HH:MM:SS » de la seconde courante, recalculé seulement quand elle change
+    struct SecondCache {
+        int64_t second = -1;
+        char    text[32] = {};
+    };
+
+    void appendTimestamp(std::string& out, uint64_t ns, SecondCache& cache) {
+        auto sec = static_cast<int64_t>(ns / 1000000000ull);
+        if (sec != cache.second) {
+            std::time_t tt = static_cast<std::time_t>(sec);
+            std::tm     tm{};
+#if defined(_WIN32)
+            localtime_s(&tm, &tt);
+#else
+            localtime_r(&tt, &tm);
+#endif
+            std::strftime(cache.text, sizeof cache.text, "%F %T", &tm);
+            cache.second = sec;
+        }
+        out += cache.text;
+        unsigned ms = static_cast<unsigned>(ns / 1000000ull % 1000);
+        out += '.';
+        out += static_cast<char>('0' + ms / 100);
+        out += static_cast<char>('0' + ms / 10 % 10);
+        out += static_cast<char>('0' + ms % 10);
+    }
+
+    // Argument suivant de l'enregistrement ; false s'il n'y en a plus
+    bool appendArg(std::string& out, const Record& r, size_t& pos) {
+        if (pos >= r.used)
+            return false;
+        auto tag = static_cast<Tag>(r.data[pos++]);
+        const unsigned char* p = r.data + pos;
+        char buf[32];
+        switch (tag) {
+            case Tag::Int: {
+                int64_t v; std::memcpy(&v, p, 8); pos += 8;
+                out.append(buf, std::to_chars(buf, buf + sizeof buf, v).ptr);
+                break;
+            }
+            case Tag::Uint: {
+                uint64_t v; std::memcpy(&v, p, 8); pos += 8;
+                out.append(buf, std::to_chars(buf, buf + sizeof buf, v).ptr);
+                break;
+            }
+            case Tag::Float: {
+                // même rendu que std::to_string(double)
+                double v; std::memcpy(&v, p, 8); pos += 8;
+                auto res = std::to_chars(buf, buf + sizeof buf, v, std::chars_format::fixed, 6);
+                if (res.ec == std::errc{}) out.append(buf, res.ptr);
+                else                       out += std::to_string(v);
+                break;
+            }
+            case Tag::Bool:
+                out += *p ? "true" : "false";
+                pos += 1;
+                break;
+            case Tag::Char:
+                out += static_cast<char>(*p);
+                pos += 1;
+                break;
+            case Tag::Str: {
+                uint16_t len; std::memcpy(&len, p, 2);
+                out.append(reinterpret_cast<const char*>(p + 2), len);
+                pos += 2 + len;
+                break;
+            }
+            case Tag::Custom: {
+                size_t          size = *p;
+                CustomFormatter f;
+                std::memcpy(&f, p + 1, sizeof f);
+                f(out, p + 1 + sizeof f);
+                pos += 1 + sizeof f + size;
+                break;
+            }
+        }
+        return true;
+    }
+
+} // namespace
+
+uint64_t nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+void appendStreamed(std::string& out, const void* value, void (*stream)(void* os, const void* value)) {
+    std::ostringstream os;
+    stream(&os, value);
+    out += os.str();
 }
+
+void formatRecord(std::string& out, const Record& r) {
+    static thread_local SecondCache cache;
+    appendTimestamp(out, r.ns, cache);
+    out += ' ';
+    out += toString(r.level);
+    out += ' ';
+
+    size_t pos = 0;
+    for (const char* f = r.format; *f; ++f) {
+        if (f[0] == '{' && f[1] == '}') {
+            if (!appendArg(out, r, pos))
+                out += "{}";   // argument manquant (ou perdu, voir ci-dessous)
+            ++f;
+        }
+        else {
+            out += *f;
+        }
+    }
+    if (r.truncated)
+        out += " [tronqué]";
+}
+
+void submit(const Record& r) {
+    Backend& b = backend();
+    if (!b.running.load(std::memory_order_acquire)) {
+        writeNow(r);
+        return;
+    }
+    Ring*   ring = localRing(b);
+    Backoff backoff;
+    while (!ring->queue.tryPush(r)) {
+        if (!b.running.load(std::memory_order_acquire)) {
+            writeNow(r);
+            return;
+        }
+        backoff.pause();
+    }
+}
+
+} // namespace logdetail
+
+namespace {
+    using logdetail::Record;
+
+    void drainLoop() {
+        auto&               b = logdetail::backend();
+        std::vector<Record> batch;
+        std::string         text;
+        std::vector<std::shared_ptr<logdetail::Ring>> rings;
+        while (true) {
+            // arrêt lu avant de vider : le dernier tour voit tous les messages déjà poussés
+            bool stopping = !b.running.load(std::memory_order_acquire);
+            {
+                std::lock_guard<std::mutex> lock(b.mutex);
+                // anneaux de threads terminés et entièrement vidés : on les oublie
+                b.rings.erase(std::remove_if(b.rings.begin(), b.rings.end(), [](auto const& r) {
+                    return r->retired.load(std::memory_order_acquire) && r->queue.size() == 0;
+                }), b.rings.end());
+                rings = b.rings;
+            }
+
+            batch.clear();
+            for (auto& ring : rings) {
+                Record rec;
+                while (ring->queue.tryPop(rec))
+                    batch.push_back(rec);
+            }
+            if (batch.empty()) {
+                if (stopping) return;
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                continue;
+            }
+
+            // fusion des threads par horodatage, l'ordre de chaque thread étant conservé
+            std::stable_sort(batch.begin(), batch.end(),
+                             [](const Record& a, const Record& c) { return a.ns < c.ns; });
+            text.clear();
+            for (auto const& rec : batch) {
+                logdetail::formatRecord(text, rec);
+                text += '\n';
+            }
+            std::lock_guard<std::mutex> lock(b.outMutex);
+            std::cout << text << std::flush;
+        }
+    }
+}
+
+void startAsyncLogging(size_t ringCapacity) {
+    auto& b = logdetail::backend();
+    std::lock_guard<std::mutex> lock(b.mutex);
+    if (b.running.load(std::memory_order_relaxed))
+        return;
+    b.capacity = ringCapacity;
+    b.rings.clear();
+    b.generation.fetch_add(1, std::memory_order_release);   // les threads recréent leur anneau
+    b.running.store(true, std::memory_order_release);
+    b.worker = std::thread(drainLoop);
+}
+
+void stopAsyncLogging() {
+    auto& b = logdetail::backend();
+    std::thread worker;
+    {
+        std::lock_guard<std::mutex> lock(b.mutex);
+        if (!b.running.load(std::memory_order_relaxed))
+            return;
+        b.running.store(false, std::memory_order_release);
+        worker = std::move(b.worker);
+    }
+    worker.join();
+}
+
+} // namespace me
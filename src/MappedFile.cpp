@@ -0,0 +1,82 @@
+#include "MappedFile.h"
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ME_HAS_MMAP 1
+#endif
+
+namespace me {
+
+MappedFile::MappedFile(std::string const& filename) {
+#if defined(ME_HAS_MMAP)
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("Impossible d'ouvrir « " + filename + " »");
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Impossible de lire la taille de « " + filename + " »");
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    if (size_ > 0) {
+        void* p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("mmap impossible sur « " + filename + " »");
+        }
+        // lecture strictement séquentielle : lecture anticipée agressive
+        ::madvise(p, size_, MADV_SEQUENTIAL);
+        data_   = static_cast<const char*>(p);
+        mapped_ = true;
+    }
+    ::close(fd);   // la projection reste valide après fermeture du descripteur
+#else
+    std::ifstream in(filename, std::ios::binary);
+    if (!in.is_open())
+        throw std::runtime_error("Impossible d'ouvrir « " + filename + " »");
+    fallback_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    data_ = fallback_.data();
+    size_ = fallback_.size();
+#endif
+}
+
+MappedFile::~MappedFile() {
+    release();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        mapped_   = other.mapped_;
+        fallback_ = std::move(other.fallback_);
+        data_     = mapped_ ? other.data_ : fallback_.data();
+        size_     = other.size_;
+        other.data_   = nullptr;
+        other.size_   = 0;
+        other.mapped_ = false;
+    }
+    return *this;
+}
+
+void MappedFile::release() {
+#if defined(ME_HAS_MMAP)
+    if (mapped_)
+        ::munmap(const_cast<char*>(data_), size_);
+#endif
+    data_   = nullptr;
+    size_   = 0;
+    mapped_ = false;
+    fallback_.clear();
+}
+
+} // namespace me
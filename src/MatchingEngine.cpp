@@ -1,99 +1,151 @@
 #include "MatchingEngine.h"
 #include "Logger.h"
+#include <algorithm>
 #include <stdexcept>
 
 namespace me {
 
+namespace {
+    // Résultat unique REJECTED : l'ordre n'a touché ni au carnet ni à l'état
+    MatchResult rejected(const Order& o) {
+        return {
+            o.timestamp,
+            o.order_id,
+            o.instrument,
+            o.side,
+            o.type,
+            o.quantity,
+            o.price,
+            o.action,
+            Status::REJECTED,
+            0,    // executed_quantity
+            0.0,  // execution_price
+            0     // counterparty_id
+        };
+    }
+}
+
+void MatchingEngine::reserve(size_t liveOrders) {
+    orders_.reserve(liveOrders);
+    // carnets des instruments déjà référencés : nœuds et index pour autant d'ordres
+    for (auto& book : books_)
+        if (auto* ladder = std::get_if<LadderOrderBook>(&book))
+            ladder->reserve(liveOrders);
+}
+
+void MatchingEngine::registerInstrument(Symbol instrument, const InstrumentSpec& spec) {
+    bookFor(instrument).emplace<LadderOrderBook>(spec);
+}
+
 std::vector<MatchResult> MatchingEngine::process(const Order& o) {
+    std::vector<MatchResult> results;
+    process(o, [&](const MatchResult& r) { results.push_back(r); });
+    return results;
+}
+
+void MatchingEngine::process(const Order& o, ResultSink sink) {
     // Log de l'ordre reçu
-    LOG_INFO("→ process Order{"
-             "id=" + std::to_string(o.order_id) +
-             ", instr=" + o.instrument +
-             ", side=" + toString(o.side) +
-             ", type=" + toString(o.type) +
-             ", qty=" + std::to_string(o.quantity) +
-             ", price=" + std::to_string(o.price) +
-             ", action=" + toString(o.action) +
-             "}");
+    LOG_INFO("→ process Order{id={}, instr={}, side={}, type={}, qty={}, price={}, action={}}",
+             o.order_id, o.instrument, o.side, o.type, o.quantity, o.price, o.action);
 
-    // 1) bookkeeping des quantités
-    if (o.action == Action::NEW) {
-        originalQty_[o.order_id]  = o.quantity;
-        remainingQty_[o.order_id] = o.quantity;
-    }
+    auto& book = bookFor(o.instrument);
 
-    else if (o.action == Action::MODIFY) {
-        auto it = originalQty_.find(o.order_id);
-        if (it == originalQty_.end())
-            throw std::runtime_error("MODIFY sur ordre inconnu: " + std::to_string(o.order_id));
-        uint64_t prevRem = remainingQty_[o.order_id];
+    // 0) contrôle du prix contre le référentiel de l'instrument
+    bool accepted = std::visit([&](auto& b) { return b.accepts(o); }, book);
+    if (!accepted) {
+        LOG_WARN("Ordre rejeté (prix hors bande ou hors tick) id={}", o.order_id);
+        sink(rejected(o));
+        return;
+    }
 
+    // 1) bookkeeping des quantités (copie locale : la table peut bouger pendant les fills)
+    OrderState state{ o.quantity, o.quantity };
+    if (o.action == Action::MODIFY) {
+        const OrderState* known = orders_.find(o.order_id);
+        if (!known) {
+            // ordre inconnu ou déjà terminé (exécuté / annulé)
+            LOG_WARN("MODIFY sur ordre inconnu ou terminé: {}", o.order_id);
+            sink(rejected(o));
+            return;
+        }
         // recalcul du remaining selon la coquille signalée
-        int64_t  deltaOriginal = static_cast<int64_t>(o.quantity) - static_cast<int64_t>(it->second);
-        int64_t  newRem = static_cast<int64_t>(prevRem) + deltaOriginal;
-        remainingQty_[o.order_id] = newRem < 0 ? 0 : static_cast<uint64_t>(newRem);
-        // on ne change pas originalQty_ : c'est la quantité d'origine
+        int64_t  deltaOriginal = static_cast<int64_t>(o.quantity) - static_cast<int64_t>(known->original);
+        int64_t  newRem = static_cast<int64_t>(known->remaining) + deltaOriginal;
+        // on ne change pas original : c'est la quantité d'origine
+        state = { known->original, newRem < 0 ? 0 : static_cast<uint64_t>(newRem) };
     }
     else if (o.action == Action::CANCEL) {
-        remainingQty_[o.order_id] = 0;
+        orders_.erase(o.order_id);
+        state.remaining = 0;
     }
 
-    // 2) délégation au carnet
-    auto& book = books_[o.instrument];
-    auto  fills = book.process(o);
-
-    std::vector<MatchResult> results;
-
-    // 3) pas d’execution => PENDING ou CANCELED
-    if (fills.empty()) {
-        Status st = (o.action == Action::CANCEL) ? Status::CANCELED : Status::PENDING;
-        results.push_back({
+    // 2) délégation au carnet : pour chaque crossing, on met à jour remaining
+    //    et on transmet aussitôt un MatchResult au consommateur
+    size_t fillCount = 0;
+    auto onFill = [&](const Execution& f) {
+        ++fillCount;
+        // un MODIFY ramené à 0 repose quand même avec o.quantity dans le carnet
+        state.remaining -= std::min(state.remaining, f.executed_quantity);
+        Status st = (state.remaining == 0)
+                    ? Status::EXECUTED
+                    : Status::PARTIALLY_EXECUTED;
+        sink(MatchResult{
             o.timestamp,
             o.order_id,
             o.instrument,
             o.side,
             o.type,
-            remainingQty_[o.order_id],
+            state.remaining,
             o.price,
             o.action,
             st,
-            0,    // executed_quantity
-            0.0,  // execution_price
-            0     // counterparty_id
+            f.executed_quantity,
+            f.execution_price,
+            f.resting_order_id
         });
-        return results;
-    }
+        LOG_INFO("Matching Result order={} counterparty={} qty_exe={} price={} status={}",
+                 o.order_id, f.resting_order_id, f.executed_quantity, f.execution_price, st);
+        // ordre au repos entièrement exécuté : son état n'a plus lieu d'être
+        if (f.resting_remaining == 0)
+            orders_.erase(f.resting_order_id);
+    };
+    uint64_t resting = std::visit([&](auto& b) {
+        b.process(o, onFill);
+        return b.restingQuantity(o.order_id);
+    }, book);
 
-    // 4) pour chaque crossing, on met à jour remaining et on renvoie un MatchResult
-    for (auto const& f : fills) {
-        remainingQty_[o.order_id] -= f.executed_quantity;
-        Status st = (remainingQty_[o.order_id] == 0)
-                    ? Status::EXECUTED
-                    : Status::PARTIALLY_EXECUTED;
-        results.push_back({
+    // 3) pas d’execution => PENDING ou CANCELED
+    if (fillCount == 0) {
+        Status st = (o.action == Action::CANCEL) ? Status::CANCELED : Status::PENDING;
+        sink(MatchResult{
             o.timestamp,
             o.order_id,
             o.instrument,
             o.side,
             o.type,
-            remainingQty_[o.order_id],
+            state.remaining,
             o.price,
             o.action,
             st,
-            f.executed_quantity,
-            f.execution_price,
-            f.resting_order_id
+            0,    // executed_quantity
+            0.0,  // execution_price
+            0     // counterparty_id
         });
-        LOG_INFO(
-          "Matching Result order="   + std::to_string(o.order_id)
-        + " counterparty="            + std::to_string(f.resting_order_id)
-        + " qty_exe="             + std::to_string(f.executed_quantity)
-        + " price="               + std::to_string(f.execution_price)
-        + " status="              + toString(st)
-        );
     }
 
-    return results;
+    retire(o, state, resting);
+}
+
+void MatchingEngine::retire(const Order& o, const OrderState& state, uint64_t resting) {
+    // C'est le carnet qui décide : un ordre qui n'y repose pas (exécuté, annulé,
+    // MARKET) libère son entrée, sinon on publie son état. Un MODIFY ramené à 0
+    // reste ainsi suivi tant que le carnet le garde au repos.
+    if (o.action == Action::CANCEL)
+        return;
+    if (resting == 0)
+        orders_.erase(o.order_id);
+    else
+        orders_[o.order_id] = state;
 }
 
 } // namespace me
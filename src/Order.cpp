@@ -30,30 +30,30 @@ std::string toString(Action a) {
 }
 
 // --- parsing string → enum ---
-Side sideFromString(const std::string& s) {
+Side sideFromString(std::string_view s) {
     if (s == "BUY")  return Side::BUY;
     if (s == "SELL") return Side::SELL;
-    throw std::runtime_error("Side invalide: " + s);
+    throw std::runtime_error("Side invalide: " + std::string(s));
 }
 
-Type typeFromString(const std::string& s) {
+Type typeFromString(std::string_view s) {
     if (s == "LIMIT")  return Type::LIMIT;
     if (s == "MARKET") return Type::MARKET;
-    throw std::runtime_error("Type invalide: " + s);
+    throw std::runtime_error("Type invalide: " + std::string(s));
 }
 
-Action actionFromString(const std::string& s) {
+Action actionFromString(std::string_view s) {
     if (s == "NEW")    return Action::NEW;
     if (s == "MODIFY") return Action::MODIFY;
     if (s == "CANCEL") return Action::CANCEL;
-    throw std::runtime_error("Action invalide: " + s);
+    throw std::runtime_error("Action invalide: " + std::string(s));
 }
 
 // --- méthode membre Order ---
 std::string Order::toString() const {
     return std::to_string(timestamp) + " | "
     + std::to_string(order_id)   + " | "
-    + instrument                  + " | "
+    + instrument.name()           + " | "
     + me::toString(side)          + " | "
     + me::toString(type)          + " | "
     + std::to_string(quantity)    + " @ "
@@ -63,19 +63,19 @@ std::string Order::toString() const {
 
 // --- usines statiques pour construire un Order proprement ---
 Order Order::makeLimit(uint64_t ts, uint64_t id,
-                       std::string instr,
+                       Symbol instr,
                        Side s, uint64_t qty, double p,
                        Action a) {
-    Order o{ts, id, std::move(instr), s, Type::LIMIT, qty, p, a};
+    Order o{ts, id, instr, s, Type::LIMIT, qty, p, a};
     o.validate();
     return o;
 }
 
 Order Order::makeMarket(uint64_t ts, uint64_t id,
-                        std::string instr,
+                        Symbol instr,
                         Side s, uint64_t qty,
                         Action a) {
-    Order o{ts, id, std::move(instr), s, Type::MARKET, qty, 0.0, a};
+    Order o{ts, id, instr, s, Type::MARKET, qty, 0.0, a};
     o.validate();
     return o;
 }
@@ -4,166 +4,180 @@
 
 namespace me {
 
-std::vector<Execution> OrderBook::process(const Order& o) {
+namespace {
+    // Bornes en ticks passées au stockage des niveaux ([0, -1] = pas de bande)
+    Ticks bandLow(const InstrumentSpec& spec, const TickScale& scale) {
+        return spec.hasBand() ? scale.toTicks(spec.min_price) : 0;
+    }
+    Ticks bandHigh(const InstrumentSpec& spec, const TickScale& scale) {
+        return spec.hasBand() ? scale.toTicks(spec.max_price) : -1;
+    }
+}
+
+template<template<typename> class Levels>
+BasicOrderBook<Levels>::BasicOrderBook(const InstrumentSpec& spec)
+  : spec_(spec),
+    scale_(spec.tick_size),
+    buyBook_(bandLow(spec, scale_), bandHigh(spec, scale_)),
+    sellBook_(bandLow(spec, scale_), bandHigh(spec, scale_))
+{}
+
+template<template<typename> class Levels>
+void BasicOrderBook<Levels>::reserve(size_t orders) {
+    pool_.reserve(orders);
+    index_.reserve(orders);
+}
+
+template<template<typename> class Levels>
+bool BasicOrderBook<Levels>::accepts(const Order& o) const {
+    if (o.type != Type::LIMIT || o.action == Action::CANCEL || !spec_.hasBand())
+        return true;
+    Ticks t = scale_.toTicks(o.price);
+    return scale_.onTick(o.price)
+        && t >= bandLow(spec_, scale_)
+        && t <= bandHigh(spec_, scale_);
+}
+
+template<template<typename> class Levels>
+uint64_t BasicOrderBook<Levels>::restingQuantity(uint64_t orderId) const {
+    const Locator* found = index_.find(orderId);
+    return found ? pool_[found->node].quantity : 0;
+}
+
+template<template<typename> class Levels>
+std::vector<Execution> BasicOrderBook<Levels>::process(const Order& o) {
+    std::vector<Execution> fills;
+    process(o, [&](const Execution& e) { fills.push_back(e); });
+    return fills;
+}
+
+template<template<typename> class Levels>
+void BasicOrderBook<Levels>::process(const Order& o, FillSink onFill) {
+    if (!accepts(o))
+        throw std::invalid_argument("Prix hors bande ou hors pas de cotation");
+
     // --- cas spécial : premier NEW LIMIT sur ce carnet, rien à matcher ---
     if (o.action == Action::NEW
      && o.type   == Type::LIMIT
      && buyBook_.empty()
      && sellBook_.empty())
     {
-        // on stocke l'ordre, sans jamais renvoyer de fills
-        addLimitOrder(o);
-        return {};
+        // on stocke l'ordre, sans jamais produire de fills
+        addLimitOrder(o, o.quantity);
+        return;
     }
 
     // CANCEL d’abord
     if (o.action == Action::CANCEL) {
-        cancelOrder(o);
-        return {};
+        cancelOrder(o.order_id);
+        return;
     }
     // MODIFY : on annule, puis on retombe sur le NEW
-    if (o.action == Action::MODIFY) {
-        cancelOrder(o);
-        // et on laisse tomber dans le NEW ci-dessous
-    }
+    // (un NEW sur un id encore au repos remplace de même l'ancien ordre)
+    cancelOrder(o.order_id);
     // NEW (ou MODIFY après suppression)
     switch (o.type) {
-        case Type::LIMIT:  return matchLimit(o);
-        case Type::MARKET: return matchMarket(o);
+        case Type::LIMIT:  return matchLimit(o, onFill);
+        case Type::MARKET: return matchMarket(o, onFill);
         default:
             throw std::runtime_error("Type d'ordre inconnu");
     }
-} // namespace me
+}
 
-void OrderBook::addLimitOrder(const Order& o) {
-    if (o.side == Side::BUY)
-        buyBook_[o.price].push_back(o);
+template<template<typename> class Levels>
+void BasicOrderBook<Levels>::addLimitOrder(const Order& o, uint64_t quantity) {
+    Ticks     px    = scale_.toTicks(o.price);
+    auto&     queue = (o.side == Side::BUY) ? buyBook_.open(px) : sellBook_.open(px);
+    NodeIndex n     = pool_.acquire();
+
+    auto& node    = pool_[n];
+    node.order_id = o.order_id;
+    node.quantity = quantity;
+    node.price    = px;
+    node.seq      = seq_++;
+    pool_.pushBack(queue, n);
+    index_[o.order_id] = { &queue, n, o.side };
+}
+
+template<template<typename> class Levels>
+void BasicOrderBook<Levels>::cancelOrder(uint64_t orderId) {
+    const Locator* found = index_.find(orderId);
+    if (!found)
+        return;
+    Locator loc = *found;
+    index_.erase(orderId);
+
+    // Retrait en O(1) de la FIFO ; le niveau n'est fermé que s'il devient vide
+    Ticks px = pool_[loc.node].price;
+    pool_.unlink(*loc.queue, loc.node);
+    pool_.release(loc.node);
+    if (!loc.queue->empty())
+        return;
+    if (loc.side == Side::BUY)
+        buyBook_.close(px);
     else
-        sellBook_[o.price].push_back(o);
+        sellBook_.close(px);
 }
 
-void OrderBook::cancelOrder(const Order& o) {
-    if (o.side == Side::BUY) {
-        // Annulation dans le book BUY
-        auto it = buyBook_.find(o.price);
-        if (it != buyBook_.end()) {
-            auto& dq = it->second;
-            dq.erase(std::remove_if(dq.begin(), dq.end(),
-                     [&](auto const& ex){ return ex.order_id == o.order_id; }),
-                     dq.end());
-            if (dq.empty())
-                buyBook_.erase(it);
-        }
-    }
-    else {
-        // Annulation dans le book SELL
-        auto it = sellBook_.find(o.price);
-        if (it != sellBook_.end()) {
-            auto& dq = it->second;
-            dq.erase(std::remove_if(dq.begin(), dq.end(),
-                     [&](auto const& ex){ return ex.order_id == o.order_id; }),
-                     dq.end());
-            if (dq.empty())
-                sellBook_.erase(it);
+template<template<typename> class Levels>
+template<typename Book>
+void BasicOrderBook<Levels>::sweep(Book& book, const Order& o, bool bounded,
+                                   uint64_t& remaining, FillSink onFill)
+{
+    typename Book::compare better;
+    const Ticks limit = bounded ? scale_.toTicks(o.price) : 0;
+
+    while (remaining > 0 && !book.empty()) {
+        Ticks px = book.best();
+        // prix limite strictement meilleur que le meilleur niveau opposé : plus de croisement
+        if (bounded && better(limit, px)) break;
+
+        auto&  dq    = book.level(px);
+        double price = scale_.toPrice(px);
+        while (!dq.empty() && remaining > 0) {
+            NodeIndex n       = dq.head;
+            auto&     resting = pool_[n];
+            uint64_t  traded  = std::min(remaining, resting.quantity);
+            remaining        -= traded;
+            resting.quantity -= traded;
+            onFill(Execution{ resting.order_id, o.order_id, traded, price, resting.quantity });
+            if (resting.quantity == 0) {
+                index_.erase(resting.order_id);
+                pool_.unlink(dq, n);
+                pool_.release(n);
+            }
         }
+        if (dq.empty())
+            book.close(px);
     }
 }
 
-std::vector<Execution> OrderBook::matchLimit(const Order& o) {
-    std::vector<Execution> fills;
+template<template<typename> class Levels>
+void BasicOrderBook<Levels>::matchLimit(const Order& o, FillSink onFill) {
     uint64_t remaining = o.quantity;
 
-    if (o.side == Side::BUY) {
-        // Croise contre le SELL book (prix croissants)
-        for (auto it = sellBook_.begin(); it != sellBook_.end() && remaining > 0; ) {
-            if (o.price < it->first) break;
-            auto& dq = it->second;
-            while (!dq.empty() && remaining > 0) {
-                Order resting = dq.front();
-                uint64_t traded = std::min(remaining, resting.quantity);
-                fills.push_back({ resting.order_id, o.order_id, traded, it->first });
-                remaining -= traded;
-                resting.quantity -= traded;
-                if (resting.quantity == 0)
-                    dq.pop_front();
-                else
-                    dq.front() = resting;
-            }
-            it = dq.empty() ? sellBook_.erase(it) : std::next(it);
-        }
-    }
-    else {
-        // Croise contre le BUY book (prix décroissants)
-        for (auto it = buyBook_.begin(); it != buyBook_.end() && remaining > 0; ) {
-            if (o.price > it->first) break;
-            auto& dq = it->second;
-            while (!dq.empty() && remaining > 0) {
-                Order resting = dq.front();
-                uint64_t traded = std::min(remaining, resting.quantity);
-                fills.push_back({ resting.order_id, o.order_id, traded, it->first });
-                remaining -= traded;
-                resting.quantity -= traded;
-                if (resting.quantity == 0)
-                    dq.pop_front();
-                else
-                    dq.front() = resting;
-            }
-            it = dq.empty() ? buyBook_.erase(it) : std::next(it);
-        }
-    }
+    if (o.side == Side::BUY)
+        sweep(sellBook_, o, true, remaining, onFill);   // croise contre le SELL book (prix croissants)
+    else
+        sweep(buyBook_,  o, true, remaining, onFill);   // croise contre le BUY book (prix décroissants)
 
     // Réinsertion du reliquat comme order LIMIT
-    if (remaining > 0) {
-        Order residual = o;
-        residual.quantity = remaining;
-        addLimitOrder(residual);
-    }
-
-    return fills;
+    if (remaining > 0)
+        addLimitOrder(o, remaining);
 }
 
-std::vector<Execution> OrderBook::matchMarket(const Order& o) {
-    std::vector<Execution> fills;
+template<template<typename> class Levels>
+void BasicOrderBook<Levels>::matchMarket(const Order& o, FillSink onFill) {
     uint64_t remaining = o.quantity;
 
-    if (o.side == Side::BUY) {
-        // BUY market: croise contre sellBook_, sans réinsertion
-        for (auto it = sellBook_.begin(); it != sellBook_.end() && remaining > 0; ) {
-            auto& dq = it->second;
-            while (!dq.empty() && remaining > 0) {
-                Order resting = dq.front();
-                uint64_t traded = std::min(remaining, resting.quantity);
-                fills.push_back({ resting.order_id, o.order_id, traded, it->first });
-                remaining -= traded;
-                resting.quantity -= traded;
-                if (resting.quantity == 0)
-                    dq.pop_front();
-                else
-                    dq.front() = resting;
-            }
-            it = dq.empty() ? sellBook_.erase(it) : std::next(it);
-        }
-    }
-    else {
-        // SELL market: croise contre buyBook_, sans réinsertion
-        for (auto it = buyBook_.begin(); it != buyBook_.end() && remaining > 0; ) {
-            auto& dq = it->second;
-            while (!dq.empty() && remaining > 0) {
-                Order resting = dq.front();
-                uint64_t traded = std::min(remaining, resting.quantity);
-                fills.push_back({ resting.order_id, o.order_id, traded, it->first });
-                remaining -= traded;
-                resting.quantity -= traded;
-                if (resting.quantity == 0)
-                    dq.pop_front();
-                else
-                    dq.front() = resting;
-            }
-            it = dq.empty() ? buyBook_.erase(it) : std::next(it);
-        }
-    }
-
-    return fills;
+    // MARKET : croise au meilleur prix disponible, sans réinsertion
+    if (o.side == Side::BUY)
+        sweep(sellBook_, o, false, remaining, onFill);
+    else
+        sweep(buyBook_,  o, false, remaining, onFill);
 }
 
+template class BasicOrderBook<MapLevels>;
+template class BasicOrderBook<LadderLevels>;
+
 } // namespace me
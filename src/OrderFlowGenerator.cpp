@@ -0,0 +1,191 @@
+#include "OrderFlowGenerator.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace me {
+
+OrderFlowGenerator::Kind OrderFlowGenerator::kindOf(const Order& o) {
+    switch (o.action) {
+        case Action::MODIFY: return Kind::Modify;
+        case Action::CANCEL: return Kind::Cancel;
+        case Action::NEW:    break;
+    }
+    return o.type == Type::MARKET ? Kind::NewMarket : Kind::NewLimit;
+}
+
+const char* OrderFlowGenerator::toString(Kind k) {
+    switch (k) {
+        case Kind::NewLimit:  return "NEW limit";
+        case Kind::NewMarket: return "NEW market";
+        case Kind::Modify:    return "MODIFY";
+        case Kind::Cancel:    return "CANCEL";
+    }
+    return "";
+}
+
+OrderFlowGenerator::OrderFlowGenerator(const Options& opts)
+  : opts_(opts),
+    scale_(opts.tickSize),
+    rng_(opts.seed),
+    nextId_(opts.firstOrderId)
+{
+    if (opts.instruments == 0)
+        throw std::invalid_argument("OrderFlowGenerator : au moins un instrument");
+    if (opts.minQuantity == 0 || opts.maxQuantity < opts.minQuantity)
+        throw std::invalid_argument("OrderFlowGenerator : quantités invalides");
+    double total = opts.newLimit + opts.market + opts.modify + opts.cancel;
+    if (!(total > 0.0) || opts.newLimit < 0 || opts.market < 0 || opts.modify < 0 || opts.cancel < 0)
+        throw std::invalid_argument("OrderFlowGenerator : proportions invalides");
+
+    // Zipf : poids 1 / (rang+1)^s, tirage par recherche dans la fonction de répartition
+    double acc = 0.0;
+    for (size_t k = 0; k < opts.instruments; ++k) {
+        symbols_.emplace_back(opts.symbolPrefix + std::to_string(k));
+        acc += 1.0 / std::pow(static_cast<double>(k + 1), opts.zipfExponent);
+        zipfCdf_.push_back(acc);
+    }
+    for (auto& c : zipfCdf_) c /= acc;
+
+    double weights[kKinds] = { opts.newLimit, opts.market, opts.modify, opts.cancel };
+    acc = 0.0;
+    for (size_t k = 0; k < kKinds; ++k) kindCdf_[k] = (acc += weights[k]) / total;
+
+    auto band = spec();
+    Ticks depth = static_cast<Ticks>(opts.maxOffsetTicks) + 1;
+    lo_ = scale_.toTicks(band.min_price) + depth;
+    hi_ = scale_.toTicks(band.max_price) - depth;
+    if (lo_ >= hi_)
+        throw std::invalid_argument("OrderFlowGenerator : bande trop étroite pour la profondeur");
+    mid_.assign(opts.instruments, std::clamp(scale_.toTicks(opts.startPrice), lo_, hi_));
+}
+
+InstrumentSpec OrderFlowGenerator::spec() const {
+    InstrumentSpec s;
+    s.tick_size = opts_.tickSize;
+    s.min_price = scale_.toPrice(scale_.toTicks(opts_.startPrice * (1.0 - opts_.bandFraction)));
+    s.max_price = scale_.toPrice(scale_.toTicks(opts_.startPrice * (1.0 + opts_.bandFraction)));
+    return s;
+}
+
+void OrderFlowGenerator::registerInstruments(MatchingEngine& engine) const {
+    auto s = spec();
+    for (auto const& sym : symbols_)
+        engine.registerInstrument(sym, s);
+}
+
+size_t OrderFlowGenerator::pickInstrument() {
+    double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng_);
+    auto   it = std::lower_bound(zipfCdf_.begin(), zipfCdf_.end(), u);
+    return std::min(static_cast<size_t>(it - zipfCdf_.begin()), zipfCdf_.size() - 1);
+}
+
+Ticks OrderFlowGenerator::stepMid(size_t instrument) {
+    if (opts_.volatilityTicks > 0.0) {
+        double step = std::normal_distribution<double>(0.0, opts_.volatilityTicks)(rng_);
+        mid_[instrument] = std::clamp(mid_[instrument] + static_cast<Ticks>(std::llround(step)), lo_, hi_);
+    }
+    return mid_[instrument];
+}
+
+Ticks OrderFlowGenerator::limitPrice(size_t instrument, Side side) {
+    Ticks mid = stepMid(instrument);
+    // distance au mid géométrique : la liquidité se concentre près du mid
+    std::geometric_distribution<int> offset(1.0 / (1.0 + std::max(0.0, opts_.meanOffsetTicks)));
+    Ticks d   = std::min<Ticks>(offset(rng_), opts_.maxOffsetTicks);
+    bool  cross = std::uniform_real_distribution<double>(0.0, 1.0)(rng_) < opts_.aggressiveRatio;
+    Ticks sign  = (side == Side::BUY) == cross ? 1 : -1;   // passif : BUY sous le mid, SELL au-dessus
+    return mid + sign * (cross ? d + 1 : d);
+}
+
+uint64_t OrderFlowGenerator::quantity() {
+    return std::uniform_int_distribution<uint64_t>(opts_.minQuantity, opts_.maxQuantity)(rng_);
+}
+
+void OrderFlowGenerator::addLive(const Live& l) {
+    liveIndex_[l.id] = live_.size();
+    live_.push_back(l);
+}
+
+void OrderFlowGenerator::removeLive(uint64_t id) {
+    size_t* pos = liveIndex_.find(id);
+    if (!pos) return;
+    size_t i = *pos;
+    liveIndex_.erase(id);
+    if (i + 1 != live_.size()) {
+        live_[i] = live_.back();
+        liveIndex_[live_[i].id] = i;
+    }
+    live_.pop_back();
+}
+
+Order OrderFlowGenerator::next() {
+    double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng_);
+    auto   kind = static_cast<Kind>(std::upper_bound(kindCdf_, kindCdf_ + kKinds - 1, u) - kindCdf_);
+    // rien à modifier ou annuler : nouvel ordre à la place
+    if ((kind == Kind::Modify || kind == Kind::Cancel) && live_.empty())
+        kind = Kind::NewLimit;
+
+    uint64_t ts = ++timestamp_;
+    switch (kind) {
+        case Kind::Cancel: {
+            Live l = live_[std::uniform_int_distribution<size_t>(0, live_.size() - 1)(rng_)];
+            removeLive(l.id);
+            return Order::makeLimit(ts, l.id, symbols_[l.instrument], l.side, 0, 0.0, Action::CANCEL);
+        }
+        case Kind::Modify: {
+            Live&    l = live_[std::uniform_int_distribution<size_t>(0, live_.size() - 1)(rng_)];
+            uint64_t q = quantity();
+            // le carnet remplace l'ordre au repos par la nouvelle quantité
+            l.remaining = q;
+            return Order::makeLimit(ts, l.id, symbols_[l.instrument], l.side, q,
+                                    scale_.toPrice(limitPrice(l.instrument, l.side)), Action::MODIFY);
+        }
+        case Kind::NewMarket: {
+            size_t k    = pickInstrument();
+            Side   side = (rng_() & 1) ? Side::BUY : Side::SELL;
+            stepMid(k);
+            return Order::makeMarket(ts, nextId_++, symbols_[k], side, quantity(), Action::NEW);
+        }
+        case Kind::NewLimit:
+            break;
+    }
+    size_t   k    = pickInstrument();
+    Side     side = (rng_() & 1) ? Side::BUY : Side::SELL;
+    uint64_t q    = quantity();
+    uint64_t id   = nextId_++;
+    addLive({ id, static_cast<uint32_t>(k), side, q });
+    return Order::makeLimit(ts, id, symbols_[k], side, q, scale_.toPrice(limitPrice(k, side)), Action::NEW);
+}
+
+void OrderFlowGenerator::observe(const MatchResult& r) {
+    // reliquat tel que le carnet le voit : chaque exécution le réduit, des deux côtés
+    auto consume = [&](uint64_t id) {
+        if (size_t* pos = liveIndex_.find(id)) {
+            Live& l = live_[*pos];
+            if (l.remaining <= r.executed_quantity) removeLive(id);
+            else                                     l.remaining -= r.executed_quantity;
+        }
+    };
+    if (r.executed_quantity > 0) {
+        consume(r.counterparty_id);
+        consume(r.order_id);
+    }
+    // statut terminal ou plus rien à exécuter côté moteur : l'ordre n'est plus modifiable
+    bool done = r.status == Status::EXECUTED || r.status == Status::CANCELED
+             || r.status == Status::REJECTED || r.quantity == 0;
+    if (done)
+        removeLive(r.order_id);
+}
+
+void OrderFlowGenerator::feed(MatchingEngine& engine, size_t n, ResultSink sink) {
+    for (size_t i = 0; i < n; ++i) {
+        Order o = next();
+        engine.process(o, [&](const MatchResult& r) {
+            observe(r);
+            sink(r);
+        });
+    }
+}
+
+} // namespace me
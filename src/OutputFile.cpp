@@ -0,0 +1,235 @@
+#include "OutputFile.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#define ME_POSIX_IO 1
+#endif
+
+namespace me {
+
+OutputFile::OutputFile(const std::string& filename, const Options& opts)
+  : opts_(opts), filename_(filename)
+{
+#if defined(ME_POSIX_IO)
+    fd_ = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0)
+        throw std::runtime_error("Impossible d'ouvrir « " + filename + " »");
+#else
+    file_ = std::fopen(filename.c_str(), "wb");
+    if (!file_)
+        throw std::runtime_error("Impossible d'ouvrir « " + filename + " »");
+    std::setvbuf(file_, nullptr, _IONBF, 0);
+#endif
+    open_ = true;
+
+    size_t count = opts_.async ? std::max<size_t>(opts_.buffers, 2) : 1;
+    pool_.resize(count);
+    for (auto& b : pool_)
+        b.resize(std::max<size_t>(opts_.bufferBytes, 1));
+    buf_ = pool_[0].data();
+    cap_ = pool_[0].size();
+
+    if (opts_.async) {
+        for (size_t i = 1; i < count; ++i)
+            free_.push_back(i);
+        writer_ = std::thread([this] { writerLoop(); });
+    }
+}
+
+OutputFile::~OutputFile() {
+    try {
+        close();
+    } catch (const std::exception& e) {
+        LOG_ERROR("OutputFile : fermeture impossible : {}", e.what());
+    }
+    // close() a pu échouer avant d'arrêter le thread d'écriture
+    if (writer_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        fullCv_.notify_all();
+        writer_.join();
+    }
+}
+
+void OutputFile::writeAll(const char* data, size_t n) {
+#if defined(ME_POSIX_IO)
+    while (n > 0) {
+        ssize_t w = ::write(fd_, data, n);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Écriture de « " + filename_ + " » impossible : " + std::strerror(errno));
+        }
+        data += w;
+        n    -= static_cast<size_t>(w);
+    }
+#else
+    if (std::fwrite(data, 1, n, file_) != n)
+        throw std::runtime_error("Écriture de « " + filename_ + " » impossible");
+#endif
+}
+
+void OutputFile::makeRoom(size_t n) {
+    flush();
+    if (n > cap_) {
+        pool_[current_].resize(n);
+        buf_ = pool_[current_].data();
+        cap_ = n;
+    }
+}
+
+void OutputFile::flush() {
+    if (used_ == 0)
+        return;
+    if (opts_.async) {
+        handOff();
+        return;
+    }
+    writeAll(buf_, used_);
+    used_ = 0;
+}
+
+void OutputFile::handOff() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (error_)
+        std::rethrow_exception(error_);
+    full_.push_back({ current_, buf_, used_ });
+    fullCv_.notify_one();
+
+    if (free_.empty()) {
+        ++stalls_;
+        if (opts_.backpressure == Backpressure::Grow) {
+            pool_.emplace_back(opts_.bufferBytes);
+            free_.push_back(pool_.size() - 1);
+        }
+        else {
+            freeCv_.wait(lock, [&] { return !free_.empty() || error_; });
+            if (error_)
+                std::rethrow_exception(error_);
+        }
+    }
+    current_ = free_.back();
+    free_.pop_back();
+    buf_  = pool_[current_].data();
+    cap_  = pool_[current_].size();
+    used_ = 0;
+}
+
+void OutputFile::writerLoop() {
+    while (true) {
+        Pending next;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            fullCv_.wait(lock, [&] { return !full_.empty() || stop_; });
+            if (full_.empty())
+                return;   // arrêt, tout est écrit
+            next = full_.front();
+            full_.pop_front();
+            writing_ = true;
+        }
+        std::exception_ptr error;
+        try {
+            writeAll(next.data, next.bytes);
+        } catch (...) {
+            error = std::current_exception();
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (error && !error_)
+                error_ = error;
+            free_.push_back(next.index);
+            writing_ = false;
+        }
+        freeCv_.notify_all();
+    }
+}
+
+void OutputFile::drain() {
+    flush();
+    if (!opts_.async)
+        return;
+    std::unique_lock<std::mutex> lock(mutex_);
+    freeCv_.wait(lock, [&] { return (full_.empty() && !writing_) || error_; });
+}
+
+void OutputFile::rethrowWriterError() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (error_)
+        std::rethrow_exception(error_);
+}
+
+void OutputFile::writeAt(uint64_t offset, const void* data, size_t n) {
+    drain();
+    rethrowWriterError();
+#if defined(ME_POSIX_IO)
+    auto* p = static_cast<const char*>(data);
+    while (n > 0) {
+        ssize_t w = ::pwrite(fd_, p, n, static_cast<off_t>(offset));
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Écriture de « " + filename_ + " » impossible : " + std::strerror(errno));
+        }
+        p      += w;
+        n      -= static_cast<size_t>(w);
+        offset += static_cast<uint64_t>(w);
+    }
+#else
+    long back = std::ftell(file_);
+    if (std::fseek(file_, static_cast<long>(offset), SEEK_SET) != 0
+        || std::fwrite(data, 1, n, file_) != n
+        || std::fseek(file_, back, SEEK_SET) != 0)
+        throw std::runtime_error("Écriture de « " + filename_ + " » impossible");
+#endif
+}
+
+void OutputFile::close() {
+    if (!open_)
+        return;
+    open_ = false;   // même en cas d'erreur : pas de second essai depuis le destructeur
+
+    std::exception_ptr error;
+    try {
+        drain();
+    } catch (...) {
+        error = std::current_exception();
+    }
+    if (writer_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+            if (!error) error = error_;
+        }
+        fullCv_.notify_all();
+        writer_.join();
+    }
+
+#if defined(ME_POSIX_IO)
+    if (!error && opts_.durable) {
+#if defined(__APPLE__)
+        bool synced = ::fsync(fd_) == 0;
+#else
+        bool synced = ::fdatasync(fd_) == 0;
+#endif
+        if (!synced)
+            error = std::make_exception_ptr(std::runtime_error(
+                "Synchronisation de « " + filename_ + " » impossible : " + std::strerror(errno)));
+    }
+    if (::close(fd_) != 0 && !error)
+        error = std::make_exception_ptr(std::runtime_error("Fermeture de « " + filename_ + " » impossible"));
+    fd_ = -1;
+#else
+    if (std::fclose(file_) != 0 && !error)
+        error = std::make_exception_ptr(std::runtime_error("Fermeture de « " + filename_ + " » impossible"));
+    file_ = nullptr;
+#endif
+    if (error)
+        std::rethrow_exception(error);
+}
+
+} // namespace me
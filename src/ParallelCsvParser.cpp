@@ -0,0 +1,138 @@
+#include "ParallelCsvParser.h"
+#include <algorithm>
+#include <cstring>
+
+namespace me {
+
+ParallelCsvParser::ParallelCsvParser(std::string const& filename, const Options& opts)
+  : file_(filename), skipInvalid_(opts.skipInvalid)
+{
+    // l'en-tête est sauté, comme pour CsvParser
+    const char* data = file_.data();
+    size_t      size = file_.size();
+    auto*       nl   = size ? static_cast<const char*>(std::memchr(data, '\n', size)) : nullptr;
+    size_t      body = nl ? static_cast<size_t>(nl - data) + 1 : size;
+    split(body, std::max<size_t>(opts.chunkBytes, 1));
+
+    size_t threads = opts.threads ? opts.threads : std::thread::hardware_concurrency();
+    threads  = std::max<size_t>(1, std::min(threads, chunks_.size()));
+    window_  = opts.window ? opts.window : 2 * threads;
+    for (size_t k = 0; k < threads && !chunks_.empty(); ++k)
+        workers_.emplace_back([this] { work(); });
+}
+
+ParallelCsvParser::~ParallelCsvParser() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    spaceCv_.notify_all();
+    for (auto& t : workers_)
+        t.join();
+}
+
+void ParallelCsvParser::split(size_t bodyStart, size_t chunkBytes) {
+    const char* data = file_.data();
+    size_t      size = file_.size();
+    for (size_t begin = bodyStart; begin < size;) {
+        size_t end = begin + chunkBytes;
+        if (end >= size) {
+            end = size;
+        }
+        else {
+            // on prolonge le bloc jusqu'à la fin de sa dernière ligne
+            auto* nl = static_cast<const char*>(std::memchr(data + end - 1, '\n', size - end + 1));
+            end      = nl ? static_cast<size_t>(nl - data) + 1 : size;
+        }
+        chunks_.push_back(Chunk{ begin, end, {}, {}, 0, nullptr, false });
+        begin = end;
+    }
+}
+
+void ParallelCsvParser::work() {
+    while (true) {
+        size_t k;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            spaceCv_.wait(lock, [&] {
+                return stop_ || nextToParse_ >= chunks_.size() || nextToParse_ < delivered_ + window_;
+            });
+            if (stop_ || nextToParse_ >= chunks_.size())
+                return;
+            k = nextToParse_++;
+        }
+
+        Chunk&                  c = chunks_[k];
+        std::vector<Order>      orders;
+        std::vector<ParseError> errors;
+        size_t                  lines = 0;
+        std::exception_ptr      error;
+        try {
+            std::string_view text(file_.data() + c.begin, c.end - c.begin);
+            orders.reserve(text.size() / 48);   // ~48 octets par ligne typique
+            lines = CsvParser::parseChunk(text, orders, errors);
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            c.orders = std::move(orders);
+            c.errors = std::move(errors);
+            c.lines  = lines;
+            c.error  = error;
+            c.ready  = true;
+        }
+        readyCv_.notify_all();
+    }
+}
+
+const std::vector<Order>* ParallelCsvParser::nextBatch() {
+    // le bloc livré précédemment n'est plus référencé : on rend sa mémoire
+    if (delivered_ > 0)
+        std::vector<Order>().swap(chunks_[delivered_ - 1].orders);
+    if (halted_ || delivered_ >= chunks_.size())
+        return nullptr;
+
+    Chunk& c = chunks_[delivered_];
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        readyCv_.wait(lock, [&] { return c.ready; });
+    }
+    if (c.error)
+        std::rethrow_exception(c.error);
+
+    // arrêt à la première ligne invalide : les lignes qui la précèdent dans le bloc
+    // sont toutes valides, on ne garde que leurs ordres
+    if (!skipInvalid_ && !c.errors.empty()) {
+        c.orders.erase(c.orders.begin() + static_cast<std::ptrdiff_t>(c.errors.front().line_number - 1),
+                       c.orders.end());
+        c.errors.erase(c.errors.begin() + 1, c.errors.end());
+        halted_ = true;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        spaceCv_.notify_all();
+    }
+
+    // numéros de ligne définitifs, maintenant que les blocs précédents sont comptés
+    for (auto& e : c.errors) {
+        e.line_number += lineOffset_;
+        logParseError(e);
+        errors_.push_back(std::move(e));
+    }
+    std::vector<ParseError>().swap(c.errors);
+    lineOffset_ += c.lines;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++delivered_;
+    }
+    spaceCv_.notify_all();
+    if (halted_ && c.orders.empty())
+        return nullptr;
+    return &c.orders;
+}
+
+} // namespace me
@@ -0,0 +1,142 @@
+#include "PerfCounters.h"
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace me {
+
+namespace {
+#if defined(__linux__)
+    constexpr uint64_t cacheMiss(uint64_t cache) {
+        return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    }
+
+    struct EventSpec { uint32_t type; uint64_t config; };
+    constexpr EventSpec kSpecs[PerfCounters::kEvents] = {
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+        { PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_L1D) },
+        { PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_LL) },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+        { PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_DTLB) },
+    };
+
+    int openEvent(const EventSpec& spec) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof attr);
+        attr.size           = sizeof attr;
+        attr.type           = spec.type;
+        attr.config         = spec.config;
+        attr.disabled       = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+        attr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+#endif
+}
+
+const char* PerfCounters::name(Event e) {
+    switch (e) {
+        case Cycles:       return "cycles";
+        case Instructions: return "instructions";
+        case L1dMisses:    return "L1d misses";
+        case LlcMisses:    return "LLC misses";
+        case BranchMisses: return "branch misses";
+        case DtlbMisses:   return "dTLB misses";
+        case kEvents:      break;
+    }
+    return "";
+}
+
+PerfCounters::PerfCounters() {
+    for (int& fd : fds_) fd = -1;
+#if defined(__linux__)
+    for (int e = 0; e < kEvents; ++e) {
+        fds_[e] = openEvent(kSpecs[e]);
+        if (fds_[e] < 0 && reason_.empty())
+            reason_ = std::string("perf_event_open : ") + std::strerror(errno)
+                    + (errno == EACCES || errno == EPERM ? " (voir /proc/sys/kernel/perf_event_paranoid)" : "");
+    }
+#else
+    reason_ = "compteurs matériels non supportés sur cette plateforme";
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+#if defined(__linux__)
+    for (int fd : fds_)
+        if (fd >= 0) close(fd);
+#endif
+}
+
+bool PerfCounters::available() const {
+    for (int fd : fds_)
+        if (fd >= 0) return true;
+    return false;
+}
+
+void PerfCounters::start() {
+#if defined(__linux__)
+    if (running_) return;
+    for (int fd : fds_)
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    running_ = true;
+#endif
+}
+
+void PerfCounters::stop() {
+#if defined(__linux__)
+    if (!running_) return;
+    for (int fd : fds_)
+        if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    for (int e = 0; e < kEvents; ++e) {
+        if (fds_[e] < 0) continue;
+        uint64_t v[3] = {};   // valeur, temps activé, temps réellement compté
+        if (::read(fds_[e], v, sizeof v) != static_cast<ssize_t>(sizeof v) || v[2] == 0)
+            continue;
+        totals_[e] += static_cast<double>(v[0]) * static_cast<double>(v[1]) / static_cast<double>(v[2]);
+    }
+    running_ = false;
+#endif
+}
+
+void PerfCounters::reset() {
+    for (double& t : totals_) t = 0.0;
+}
+
+void PerfCounters::print(std::ostream& os, double units, const char* unitName) const {
+    if (!available()) {
+        os << "Compteurs matériels indisponibles : " << reason_ << "\n";
+        return;
+    }
+    if (units <= 0.0) units = 1.0;
+    os << "Compteurs matériels (par " << unitName << ") :\n";
+    auto flags = os.flags();
+    auto prec  = os.precision();
+    os << std::setfill(' ') << std::fixed << std::setprecision(2);
+    for (int e = 0; e < kEvents; ++e) {
+        os << "  " << std::left << std::setw(15) << name(static_cast<Event>(e)) << std::right;
+        if (!available(static_cast<Event>(e))) {
+            os << std::setw(12) << "n/d" << "\n";
+            continue;
+        }
+        os << std::setw(12) << totals_[e] / units;
+        if (e == Instructions && available(Cycles) && totals_[Cycles] > 0.0)
+            os << "   (IPC " << totals_[Instructions] / totals_[Cycles] << ")";
+        os << "\n";
+    }
+    os.flags(flags);
+    os.precision(prec);
+}
+
+} // namespace me
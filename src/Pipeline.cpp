@@ -0,0 +1,232 @@
+#include "Pipeline.h"
+#include "SpscQueue.h"
+#include "Threading.h"
+#include "Logger.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <iomanip>
+#include <mutex>
+#include <thread>
+
+namespace me {
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double secondsSince(Clock::time_point t0) {
+        return std::chrono::duration<double>(Clock::now() - t0).count();
+    }
+
+    template<typename Item>
+    struct Batch {
+        std::vector<Item> items;
+        bool              last = false;   // dernier lot du flux
+    };
+
+    // Lots en circulation entre deux étages : `ready` vers l'aval, `free` retour vers l'amont
+    template<typename Item>
+    struct Link {
+        Link(size_t batches, size_t batchSize)
+          : pool(batches), ready(batches), free(batches)
+        {
+            for (auto& b : pool) {
+                b.items.reserve(batchSize);
+                free.tryPush(&b);
+            }
+        }
+
+        std::vector<Batch<Item>>   pool;
+        SpscQueue<Batch<Item>*>    ready;
+        SpscQueue<Batch<Item>*>    free;
+        uint64_t                   samples = 0;
+        uint64_t                   occupancySum = 0;
+        size_t                     occupancyMax = 0;
+    };
+
+    // État partagé d'arrêt sur erreur
+    struct Abort {
+        std::atomic<bool>  flag{false};
+        std::mutex         mutex;
+        std::exception_ptr error;
+
+        void fail() {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error) error = std::current_exception();
+            flag.store(true, std::memory_order_release);
+        }
+        bool raised() const { return flag.load(std::memory_order_acquire); }
+    };
+
+    // Retire un lot de `q` en attente active ; nullptr si le pipeline est arrêté
+    template<typename T>
+    T* take(SpscQueue<T*>& q, Abort& abort) {
+        Backoff backoff;
+        T* v;
+        while (!q.tryPop(v)) {
+            if (abort.raised()) return nullptr;
+            backoff.pause();
+        }
+        return v;
+    }
+
+    template<typename Item>
+    Batch<Item>* takeReady(Link<Item>& link, Abort& abort) {
+        Batch<Item>* b = take(link.ready, abort);
+        if (b) {
+            size_t waiting = link.ready.size();   // lots encore en file derrière celui-ci
+            link.occupancySum += waiting;
+            link.occupancyMax  = std::max(link.occupancyMax, waiting);
+            ++link.samples;
+        }
+        return b;
+    }
+
+    void pin(const Pipeline::Options& opts, unsigned offset) {
+        if (opts.pinThreads && !pinCurrentThread(opts.firstCore + offset))
+            LOG_WARN("Pipeline : épinglage sur le cœur {} impossible", opts.firstCore + offset);
+    }
+}
+
+Pipeline::Pipeline(MatchingEngine& engine, const Options& opts)
+  : engine_(engine), opts_(opts)
+{
+    if (opts_.batchSize == 0 || opts_.ringBatches < 2)
+        throw std::invalid_argument("Pipeline : lots non vides et au moins 2 lots par file");
+}
+
+Pipeline::Stats Pipeline::run(OrderSource source, ResultSink sink) {
+    Link<Order>       orders (opts_.ringBatches, opts_.batchSize);
+    Link<MatchResult> results(opts_.ringBatches, opts_.batchSize);
+    Abort             abort;
+    Stats             stats;
+    auto              t0 = Clock::now();
+
+    // --- étage 1 : lecture ---
+    std::thread parse([&] {
+        StageStats& st = stats.stages[0];
+        try {
+            pin(opts_, 0);
+            bool more = true;
+            while (more) {
+                Batch<Order>* b = take(orders.free, abort);
+                if (!b) return;
+                auto w0 = Clock::now();
+                b->items.clear();
+                more    = source(b->items);
+                b->last = !more;
+                st.busy  += secondsSince(w0);
+                st.items += b->items.size();
+                ++st.batches;
+                orders.ready.tryPush(b);   // jamais pleine : ring et pool ont la même taille
+            }
+        } catch (...) {
+            abort.fail();
+        }
+        st.seconds = secondsSince(t0);
+    });
+
+    // --- étage 2 : matching ---
+    std::thread match([&] {
+        StageStats& st = stats.stages[1];
+        try {
+            pin(opts_, 1);
+            Batch<MatchResult>* out = take(results.free, abort);
+            if (!out) return;
+            out->items.clear();
+            auto send = [&](bool last) {
+                out->last = last;
+                results.ready.tryPush(out);
+                if (last) return true;
+                out = take(results.free, abort);
+                if (out) out->items.clear();
+                return out != nullptr;
+            };
+            auto collect = [&](const MatchResult& r) {
+                if (out->items.size() == opts_.batchSize && !send(false))
+                    throw std::runtime_error("Pipeline arrêté");
+                out->items.push_back(r);
+            };
+
+            bool last = false;
+            while (!last) {
+                Batch<Order>* in = takeReady(orders, abort);
+                if (!in) return;
+                auto w0 = Clock::now();
+                for (auto const& o : in->items)
+                    engine_.process(o, collect);
+                last = in->last;
+                st.items += in->items.size();
+                ++st.batches;
+                orders.free.tryPush(in);
+                st.busy += secondsSince(w0);
+                // on pousse les résultats à chaque lot d'entrée pour ne pas retarder l'écriture
+                if ((!out->items.empty() || last) && !send(last))
+                    return;
+            }
+        } catch (...) {
+            abort.fail();
+        }
+        st.seconds = secondsSince(t0);
+    });
+
+    // --- étage 3 : écriture ---
+    std::thread write([&] {
+        StageStats& st = stats.stages[2];
+        try {
+            pin(opts_, 2);
+            bool last = false;
+            while (!last) {
+                Batch<MatchResult>* b = takeReady(results, abort);
+                if (!b) return;
+                auto w0 = Clock::now();
+                for (auto const& r : b->items)
+                    sink(r);
+                last = b->last;
+                st.items += b->items.size();
+                ++st.batches;
+                results.free.tryPush(b);
+                st.busy += secondsSince(w0);
+            }
+        } catch (...) {
+            abort.fail();
+        }
+        st.seconds = secondsSince(t0);
+    });
+
+    parse.join();
+    match.join();
+    write.join();
+    if (abort.error)
+        std::rethrow_exception(abort.error);
+
+    stats.seconds = secondsSince(t0);
+    auto fill = [](QueueStats& q, const auto& link) {
+        q.capacity      = link.ready.capacity();
+        q.meanOccupancy = link.samples ? double(link.occupancySum) / double(link.samples) : 0.0;
+        q.maxOccupancy  = link.occupancyMax;
+    };
+    fill(stats.queues[0], orders);
+    fill(stats.queues[1], results);
+    return stats;
+}
+
+void Pipeline::Stats::print(std::ostream& os) const {
+    os << std::setfill(' ') << "=== Pipeline : " << std::fixed << std::setprecision(3) << seconds << " s ===\n";
+    for (auto const& s : stages) {
+        double rate = s.seconds > 0 ? double(s.items) / s.seconds : 0.0;
+        double load = s.seconds > 0 ? 100.0 * s.busy / s.seconds : 0.0;
+        os << std::left << std::setw(6) << s.name << std::right
+           << std::setw(12) << s.items << " éléments  "
+           << std::setprecision(0) << std::setw(12) << rate << " /s  "
+           << "occupé " << std::setprecision(1) << load << " %\n";
+    }
+    for (auto const& q : queues) {
+        os << "file " << q.name << " : " << std::setprecision(2) << q.meanOccupancy
+           << " lots en moyenne, max " << q.maxOccupancy << " / " << q.capacity << "\n";
+    }
+    os << std::defaultfloat;
+}
+
+} // namespace me
@@ -0,0 +1,132 @@
+#include "ShardedMatchingEngine.h"
+#include "Threading.h"
+#include "Logger.h"
+#include <stdexcept>
+
+namespace me {
+
+ShardedMatchingEngine::ShardedMatchingEngine(const Options& opts)
+  : opts_(opts),
+    // chaque ordre en vol est soit en entrée, soit en cours, soit a au moins un résultat en sortie
+    route_(opts.shards * (2 * opts.queueCapacity + 1))
+{
+    if (opts.shards == 0)
+        throw std::invalid_argument("ShardedMatchingEngine : au moins un shard");
+    for (size_t k = 0; k < opts.shards; ++k)
+        shards_.push_back(std::make_unique<Shard>(opts.queueCapacity));
+}
+
+ShardedMatchingEngine::~ShardedMatchingEngine() {
+    stop_.store(true, std::memory_order_release);
+    for (auto& s : shards_)
+        if (s->worker.joinable())
+            s->worker.join();
+}
+
+void ShardedMatchingEngine::registerInstrument(Symbol instrument, const InstrumentSpec& spec) {
+    if (started_)
+        throw std::logic_error("registerInstrument après le démarrage des shards");
+    shards_[shardOf(instrument)]->engine.registerInstrument(instrument, spec);
+}
+
+void ShardedMatchingEngine::start() {
+    started_ = true;
+    for (size_t k = 0; k < shards_.size(); ++k) {
+        auto core = static_cast<unsigned>(opts_.firstCore + k);
+        shards_[k]->worker = std::thread([this, k, core] { run(*shards_[k], core); });
+    }
+}
+
+void ShardedMatchingEngine::run(Shard& shard, unsigned core) {
+    if (opts_.pinThreads && !pinCurrentThread(core))
+        LOG_WARN("Shard : épinglage sur le cœur {} impossible", core);
+
+    // Pousse un résultat en sortie, en attendant que l'ingestion libère de la place
+    auto emit = [&](const Outbound& out) {
+        Backoff backoff;
+        while (!shard.outbound.tryPush(out)) {
+            if (stop_.load(std::memory_order_acquire)) return;
+            backoff.pause();
+        }
+    };
+
+    Backoff backoff;
+    while (true) {
+        Order* o = shard.inbound.front();
+        if (!o) {
+            if (stop_.load(std::memory_order_acquire)) return;
+            backoff.pause();
+            continue;
+        }
+        backoff.reset();
+
+        // un résultat est retenu d'un cran pour pouvoir marquer le dernier
+        bool        pending = false;
+        MatchResult held{};
+        try {
+            shard.engine.process(*o, [&](const MatchResult& r) {
+                if (pending) emit({ held, true, false, false });
+                held    = r;
+                pending = true;
+            });
+            emit({ held, pending, true, false });
+        } catch (...) {
+            if (!shard.error) shard.error = std::current_exception();
+            emit({ held, false, true, true });
+        }
+        shard.inbound.pop();
+    }
+}
+
+bool ShardedMatchingEngine::drain(ResultSink sink) {
+    bool progressed = false;
+    while (uint32_t* k = route_.front()) {
+        Shard& shard = *shards_[*k];
+        // résultats de l'ordre le plus ancien, au fur et à mesure de leur production
+        Outbound* out;
+        while ((out = shard.outbound.front())) {
+            progressed = true;
+            if (out->failed)
+                std::rethrow_exception(shard.error);
+            bool last = out->last;
+            if (out->present)
+                sink(out->result);
+            shard.outbound.pop();
+            if (last) break;
+        }
+        if (!out)
+            return progressed;   // le shard n'a pas encore fini cet ordre
+        route_.pop();
+    }
+    return progressed;
+}
+
+void ShardedMatchingEngine::submit(const Order& o, ResultSink sink) {
+    if (!started_)
+        start();
+
+    auto   k     = static_cast<uint32_t>(shardOf(o.instrument));
+    Shard& shard = *shards_[k];
+    Backoff backoff;
+    while (!shard.inbound.tryPush(o)) {
+        // file du shard pleine : on vide la sortie pour que les shards avancent
+        if (!drain(sink)) backoff.pause();
+    }
+    // route_ est dimensionnée pour tous les ordres en vol ; si elle sature quand
+    // même, on attend que drain() en retire les plus anciens
+    backoff.reset();
+    while (!route_.tryPush(k)) {
+        if (!drain(sink)) backoff.pause();
+    }
+    drain(sink);
+}
+
+void ShardedMatchingEngine::flush(ResultSink sink) {
+    Backoff backoff;
+    while (route_.front()) {
+        if (drain(sink)) backoff.reset();
+        else             backoff.pause();
+    }
+}
+
+} // namespace me
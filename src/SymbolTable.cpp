@@ -0,0 +1,55 @@
+#include "SymbolTable.h"
+#include <stdexcept>
+
+namespace me {
+
+SymbolTable::SymbolTable()
+  : owned_(new std::unique_ptr<std::string[]>[kMaxChunks])
+{
+    intern("");   // id 0 : instrument vide (Order par défaut)
+}
+
+SymbolTable& SymbolTable::global() {
+    static SymbolTable table;
+    return table;
+}
+
+std::optional<SymbolId> SymbolTable::find(std::string_view name) const {
+    std::shared_lock lock(mutex_);
+    auto it = ids_.find(name);
+    if (it == ids_.end())
+        return std::nullopt;
+    return it->second;
+}
+
+SymbolId SymbolTable::intern(std::string_view name) {
+    {
+        // chemin courant : instrument déjà connu, simple verrou partagé
+        std::shared_lock lock(mutex_);
+        auto it = ids_.find(name);
+        if (it != ids_.end())
+            return it->second;
+    }
+
+    std::unique_lock lock(mutex_);
+    auto it = ids_.find(name);
+    if (it != ids_.end())
+        return it->second;
+
+    size_t id = size_.load(std::memory_order_relaxed);
+    size_t c  = id >> kChunkBits;
+    if (c >= kMaxChunks)
+        throw std::length_error("Table des instruments pleine");
+    if (!owned_[c]) {
+        owned_[c].reset(new std::string[kChunkSize]);
+        chunks_[c].store(owned_[c].get(), std::memory_order_release);
+    }
+
+    std::string& slot = owned_[c][id & kChunkMask];
+    slot = std::string(name);
+    ids_.emplace(std::string_view{slot}, static_cast<SymbolId>(id));
+    size_.store(id + 1, std::memory_order_release);
+    return static_cast<SymbolId>(id);
+}
+
+} // namespace me
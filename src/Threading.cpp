@@ -0,0 +1,24 @@
+#include "Threading.h"
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace me {
+
+bool pinCurrentThread(unsigned core) {
+#if defined(__linux__)
+    unsigned n = std::thread::hardware_concurrency();
+    if (n == 0)
+        return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core % n, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)core;
+    return false;
+#endif
+}
+
+} // namespace me
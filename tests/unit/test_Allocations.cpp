@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "AllocationCounter.h"
+#include "OrderFlowGenerator.h"
+#include "Logger.h"
+
+using namespace me;
+
+// Exécutable lié à alloc_hooks (voir CMakeLists.txt) : operator new / delete comptés
+TEST(Allocations, HooksCountThreadAllocations) {
+    ASSERT_TRUE(alloc::hooksInstalled());
+    alloc::Scope scope;
+    {
+        std::vector<int> v(1000);
+        v.push_back(1);
+    }
+    auto d = scope.delta();
+    EXPECT_EQ(d.allocations, 2u);
+    EXPECT_EQ(d.deallocations, 2u);
+    EXPECT_GE(d.bytes, 1000 * sizeof(int));
+}
+
+// Carnets référencés et pré-dimensionnés : une fois peuplés, le matching n'alloue
+// plus rien (ni conteneur de résultats, ni copie d'instrument, ni nœud de niveau)
+TEST(Allocations, SteadyStateMatchingAllocatesNothing) {
+    setLoggingEnabled(false);
+    constexpr size_t N = 20000;
+
+    OrderFlowGenerator gen;
+    MatchingEngine     engine, shadow;
+    gen.registerInstruments(engine);
+    gen.registerInstruments(shadow);
+    engine.reserve(1 << 14);
+    std::vector<Order> flow;
+    for (size_t i = 0; i < 2 * N; ++i) {
+        flow.push_back(gen.next());
+        shadow.process(flow.back(), [&](const MatchResult& r) { gen.observe(r); });
+    }
+
+    size_t results = 0;
+    auto   sink    = [&](const MatchResult&) { ++results; };
+    for (size_t i = 0; i < N; ++i)
+        engine.process(flow[i], sink);
+
+    alloc::Scope scope;
+    for (size_t i = N; i < 2 * N; ++i)
+        engine.process(flow[i], sink);
+    auto d = scope.delta();
+    EXPECT_GT(results, N);
+    EXPECT_EQ(d.allocations, 0u) << d.bytes << " octets alloués en régime établi";
+}
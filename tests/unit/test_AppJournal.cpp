@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "Journal.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+    // Entrée CSV déterministe : ordres limites croisés sur trois instruments,
+    // avec des MODIFY et des CANCEL d'ordres antérieurs
+    std::string writeInput(const std::string& path, size_t lines) {
+        std::ofstream out(path);
+        out << "timestamp,order_id,instrument,side,type,quantity,price,action\n";
+        for (size_t i = 1; i <= lines; ++i) {
+            const char* sym  = i % 3 == 0 ? "AAPL" : i % 3 == 1 ? "MSFT" : "TSLA";
+            const char* side = i % 2 ? "BUY" : "SELL";
+            size_t      id   = i;
+            const char* act  = "NEW";
+            if (i % 11 == 0)      { id = i - 6; act = "MODIFY"; side = id % 2 ? "BUY" : "SELL"; }
+            else if (i % 17 == 0) { id = i - 12; act = "CANCEL"; side = id % 2 ? "BUY" : "SELL"; }
+            if (act != std::string("NEW"))
+                sym = id % 3 == 0 ? "AAPL" : id % 3 == 1 ? "MSFT" : "TSLA";
+            out << 1617278400000000000ULL + i * 1000 << ',' << id << ',' << sym << ',' << side
+                << ",LIMIT," << 5 + i % 23 << ',' << 100 + (i * 7) % 9 << ".5," << act << '\n';
+        }
+        return path;
+    }
+
+    std::string readAll(const std::string& path) {
+        std::ifstream in(path);
+        std::ostringstream ss;
+        ss << in.rdbuf();
+        return ss.str();
+    }
+
+    int runApp(const std::string& args) {
+        std::string cmd = std::string(APP_PATH) + " " + args + " > /dev/null 2>&1";
+        return std::system(cmd.c_str());
+    }
+
+    struct TempDir {
+        explicit TempDir(const std::string& name) : path("tests/data/tmp_app_" + name) {
+            fs::remove_all(path);
+            fs::create_directories(path);
+        }
+        ~TempDir() { fs::remove_all(path); }
+        std::string file(const std::string& name) const { return path + "/" + name; }
+        std::string path;
+    };
+
+    uint64_t journalSize(const std::string& dir) {
+        return me::Journal::replay(dir, [](uint64_t, const me::Order&) {});
+    }
+}
+
+// Relancer l'application sur la même entrée avec le même journal : rien n'est
+// rejoué deux fois, la sortie est celle d'une exécution unique, quel que soit le mode
+TEST(AppJournal, RestartOnSameInputMatchesCleanRun) {
+    for (std::string mode : { "", "--shards 2", "--pipeline" }) {
+        TempDir     tmp("restart");
+        std::string input = writeInput(tmp.file("input.csv"), 600);
+        std::string io    = " --input " + input + " --output ";
+        ASSERT_EQ(runApp(mode + io + tmp.file("clean.csv")), 0) << mode;
+        std::string clean = readAll(tmp.file("clean.csv"));
+        ASSERT_FALSE(clean.empty());
+
+        std::string journal = " --journal " + tmp.file("journal");
+        ASSERT_EQ(runApp(mode + io + tmp.file("first.csv") + journal), 0) << mode;
+        ASSERT_EQ(runApp(mode + io + tmp.file("second.csv") + journal), 0) << mode;
+        EXPECT_EQ(readAll(tmp.file("first.csv")), clean) << mode;
+        EXPECT_EQ(readAll(tmp.file("second.csv")), clean) << mode;
+        EXPECT_EQ(journalSize(tmp.file("journal")), 600u) << mode;
+    }
+}
+
+// Reprise après un arrêt en cours de fichier : le journal couvre un préfixe de
+// l'entrée, seule la suite est journalisée et la sortie est complète
+TEST(AppJournal, ResumesAfterJournaledPrefix) {
+    TempDir     tmp("resume");
+    std::string input = writeInput(tmp.file("input.csv"), 600);
+    std::string head  = writeInput(tmp.file("head.csv"), 250);
+    ASSERT_EQ(runApp("--input " + input + " --output " + tmp.file("clean.csv")), 0);
+
+    std::string journal = " --journal " + tmp.file("journal");
+    ASSERT_EQ(runApp("--input " + head + " --output " + tmp.file("head_out.csv") + journal), 0);
+    EXPECT_EQ(journalSize(tmp.file("journal")), 250u);
+    ASSERT_EQ(runApp("--input " + input + " --output " + tmp.file("resumed.csv") + journal), 0);
+    EXPECT_EQ(readAll(tmp.file("resumed.csv")), readAll(tmp.file("clean.csv")));
+    EXPECT_EQ(journalSize(tmp.file("journal")), 600u);
+}
+
+// Entrée qui ne commence pas par les ordres du journal, ou plus courte que lui : refusée
+TEST(AppJournal, RejectsInputThatDoesNotExtendTheJournal) {
+    TempDir     tmp("mismatch");
+    std::string input = writeInput(tmp.file("input.csv"), 300);
+    std::string head  = writeInput(tmp.file("head.csv"), 100);
+    std::string journal = " --journal " + tmp.file("journal");
+    ASSERT_EQ(runApp("--input " + input + " --output " + tmp.file("out.csv") + journal), 0);
+
+    EXPECT_NE(runApp("--input " + head + " --output " + tmp.file("short.csv") + journal), 0);
+
+    std::string other = tmp.file("other.csv");
+    {
+        std::ifstream in(input);
+        std::ofstream out(other);
+        std::string   line;
+        for (size_t n = 0; std::getline(in, line); ++n)
+            out << (n == 42 ? line.replace(line.find(",LIMIT,") + 7, 1, "9") : line) << '\n';
+    }
+    EXPECT_NE(runApp("--input " + other + " --output " + tmp.file("other_out.csv") + journal), 0);
+    EXPECT_EQ(journalSize(tmp.file("journal")), 300u);
+}
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <sstream>
+#include "BenchReport.h"
+#include "LatencyHistogram.h"
+
+using namespace me;
+
+namespace {
+    BenchReport::Metric metric(bool higherIsBetter, std::vector<double> samples) {
+        return { "m", "ns", higherIsBetter, std::move(samples) };
+    }
+}
+
+// Écriture puis relecture : métadonnées, paramètres et échantillons identiques
+TEST(BenchReport, RoundTrip) {
+    BenchReport r("Performance");
+    r.setParam("mode", "replay \"rapide\"");
+    r.add("match.throughput", "ordres/s", true, 1.5e6);
+    r.add("match.throughput", "ordres/s", true, 1.25e6);
+    r.add("match.ns_per_order", "ns", false, 666.6666666666666);
+    LatencyHistogram h;
+    for (uint64_t v = 1; v <= 1000; ++v) h.record(v);
+    r.addLatency("total", h);
+
+    std::ostringstream os;
+    r.write(os);
+    BenchReport back = BenchReport::parse(os.str());
+
+    EXPECT_EQ(back.benchmark(), "Performance");
+    EXPECT_EQ(back.gitRevision(), BenchReport::currentGitRevision());
+    EXPECT_EQ(back.cpuModel(), r.cpuModel());
+    ASSERT_EQ(back.metrics().size(), r.metrics().size());
+    for (size_t i = 0; i < r.metrics().size(); ++i) {
+        EXPECT_EQ(back.metrics()[i].name, r.metrics()[i].name);
+        EXPECT_EQ(back.metrics()[i].unit, r.metrics()[i].unit);
+        EXPECT_EQ(back.metrics()[i].higherIsBetter, r.metrics()[i].higherIsBetter);
+        EXPECT_EQ(back.metrics()[i].samples, r.metrics()[i].samples);
+    }
+    const auto* p99 = back.find("total.p99");
+    ASSERT_NE(p99, nullptr);
+    EXPECT_FALSE(p99->higherIsBetter);
+    EXPECT_EQ(p99->samples.size(), 1u);
+}
+
+// Sortie Google Benchmark : une métrique par compteur, une valeur par répétition,
+// agrégats ignorés
+TEST(BenchReport, ImportsGoogleBenchmarkJson) {
+    const std::string json = R"({
+      "context": { "executable": "/tmp/build/OrderBookBench", "git_revision": "abc1234",
+                   "cpu_model": "Test CPU", "caches": [ { "type": "Data", "size": 32768 } ] },
+      "benchmarks": [
+        { "name": "Add/1", "run_name": "Add/1", "run_type": "iteration", "repetitions": 2,
+          "iterations": 1000, "real_time": 10.5, "cpu_time": 10.4, "time_unit": "ns",
+          "items_per_second": 9.5e7, "op": 1.05e-8 },
+        { "name": "Add/1", "run_name": "Add/1", "run_type": "iteration", "repetitions": 2,
+          "iterations": 1000, "real_time": 11.5, "cpu_time": 11.4, "time_unit": "ns",
+          "items_per_second": 8.7e7, "op": 1.15e-8 },
+        { "name": "Add/1_mean", "run_name": "Add/1", "run_type": "aggregate",
+          "real_time": 11.0, "cpu_time": 10.9, "time_unit": "ns" }
+      ]
+    })";
+    BenchReport r = BenchReport::parse(json);
+    EXPECT_EQ(r.benchmark(), "OrderBookBench");
+    EXPECT_EQ(r.gitRevision(), "abc1234");
+    EXPECT_EQ(r.cpuModel(), "Test CPU");
+
+    const auto* rt = r.find("Add/1.real_time");
+    ASSERT_NE(rt, nullptr);
+    EXPECT_EQ(rt->samples, (std::vector<double>{ 10.5, 11.5 }));
+    EXPECT_FALSE(rt->higherIsBetter);
+    const auto* ips = r.find("Add/1.items_per_second");
+    ASSERT_NE(ips, nullptr);
+    EXPECT_TRUE(ips->higherIsBetter);
+    EXPECT_EQ(r.find("Add/1.iterations"), nullptr);
+}
+
+TEST(BenchReport, RejectsMalformedJson) {
+    EXPECT_THROW(BenchReport::parse("{ \"metrics\": [ "), std::runtime_error);
+    EXPECT_THROW(BenchReport::parse("[]"), std::runtime_error);
+    EXPECT_THROW(BenchReport::parse("{ \"benchmark\": \"x\" }"), std::runtime_error);
+}
+
+// Écart net et passes peu dispersées : régression ou amélioration selon le sens
+TEST(MetricComparison, FlagsSignificantChangesInTheRightDirection) {
+    auto slow = metric(false, { 110, 111, 109, 110, 112 });
+    auto fast = metric(false, { 100, 101, 99, 100, 100 });
+    auto c = compareMetric(fast, slow, 0.02);
+    EXPECT_EQ(c.verdict, MetricComparison::Regression);
+    EXPECT_NEAR(c.change, 0.104, 0.001);
+    EXPECT_GT(c.ciLow, 0.0);
+    EXPECT_LT(c.ciLow, c.change);
+    EXPECT_GT(c.ciHigh, c.change);
+    EXPECT_EQ(compareMetric(slow, fast, 0.02).verdict, MetricComparison::Improvement);
+
+    // débit : plus haut = mieux, le même écart change de sens
+    auto lowRate  = metric(true, { 100, 101, 99, 100, 100 });
+    auto highRate = metric(true, { 110, 111, 109, 110, 112 });
+    EXPECT_EQ(compareMetric(highRate, lowRate, 0.02).verdict, MetricComparison::Regression);
+}
+
+// Bruit : intervalle qui contient zéro, ou écart sous le seuil
+TEST(MetricComparison, IgnoresNoiseAndSmallChanges) {
+    auto a = metric(false, { 100, 130, 90, 120, 95 });
+    auto b = metric(false, { 110, 95, 125, 100, 105 });
+    auto c = compareMetric(a, b, 0.02);
+    EXPECT_EQ(c.verdict, MetricComparison::Unchanged);
+    EXPECT_LT(c.ciLow, 0.0);
+    EXPECT_GT(c.ciHigh, 0.0);
+
+    auto tight  = metric(false, { 100.0, 100.1, 99.9, 100.0 });
+    auto tight2 = metric(false, { 101.0, 101.1, 100.9, 101.0 });
+    EXPECT_EQ(compareMetric(tight, tight2, 0.02).verdict, MetricComparison::Unchanged);
+    EXPECT_EQ(compareMetric(tight, tight2, 0.005).verdict, MetricComparison::Regression);
+}
+
+// Une seule passe : pas de dispersion, pas de verdict
+TEST(MetricComparison, SingleRunIsInconclusive) {
+    auto c = compareMetric(metric(false, { 100 }), metric(false, { 200 }), 0.02);
+    EXPECT_EQ(c.verdict, MetricComparison::Inconclusive);
+    EXPECT_DOUBLE_EQ(c.change, 1.0);
+}
+
+// Référence nulle (zéro allocation) : tout écart compte, même sur une seule passe
+TEST(MetricComparison, ZeroBaselineFlagsAnyChange) {
+    auto none = metric(false, { 0 });
+    auto some = metric(false, { 0.29 });
+    auto c = compareMetric(none, some, 0.02);
+    EXPECT_EQ(c.verdict, MetricComparison::Regression);
+    EXPECT_TRUE(std::isinf(c.change));
+    EXPECT_GT(c.change, 0.0);
+    EXPECT_EQ(compareMetric(none, metric(false, { 0, 0, 0 }), 0.02).verdict, MetricComparison::Unchanged);
+
+    // plus haut = mieux : la même hausse est une amélioration
+    EXPECT_EQ(compareMetric(metric(true, { 0 }), metric(true, { 5 }), 0.02).verdict,
+              MetricComparison::Improvement);
+}
+
+// Variance nulle des deux côtés : comparaison exacte au seuil, sans test de Welch
+TEST(MetricComparison, DeterministicMetricsCompareExactly) {
+    auto c = compareMetric(metric(false, { 2, 2, 2 }), metric(false, { 2.5, 2.5, 2.5 }), 0.02);
+    EXPECT_EQ(c.verdict, MetricComparison::Regression);
+    EXPECT_DOUBLE_EQ(c.change, 0.25);
+    EXPECT_DOUBLE_EQ(c.ciLow, c.change);
+    EXPECT_DOUBLE_EQ(c.ciHigh, c.change);
+    EXPECT_EQ(compareMetric(metric(false, { 100, 100 }), metric(false, { 101, 101 }), 0.02).verdict,
+              MetricComparison::Unchanged);
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include "BinaryReader.h"
+#include "BinaryWriter.h"
+
+using namespace me;
+
+// Aller-retour exact des ordres : ids, symboles, enums et prix décimaux
+TEST(BinaryFormat, OrdersRoundTrip) {
+    const std::string path = "tests/data/tmp_orders.bin";
+    std::vector<Order> orders = {
+        Order::makeLimit (1617278400000000000ull, 1, "AAPL", Side::BUY,  100, 150.25, Action::NEW),
+        Order::makeMarket(1617278400000001000ull, 2, "GOOG", Side::SELL, 10, Action::NEW),
+        Order::makeLimit (1617278400000002000ull, 3, "AAPL", Side::SELL, 7, 0.12345678, Action::MODIFY),
+        Order::makeLimit (1617278400000003000ull, 1, "MSFT", Side::BUY,  0, 0.0, Action::CANCEL),
+    };
+    {
+        BinaryOrderWriter w(path);
+        for (auto const& o : orders) w.write(o);
+        EXPECT_EQ(w.count(), orders.size());
+    }
+    ASSERT_TRUE(isBinaryOrderFile(path));
+    EXPECT_FALSE(isBinaryResultFile(path));
+
+    BinaryOrderReader r(path);
+    ASSERT_EQ(r.size(), orders.size());
+    EXPECT_EQ(r.symbols().size(), 3u);   // AAPL, GOOG, MSFT : un id par instrument
+    for (auto const& o : orders) {
+        auto got = r.next();
+        ASSERT_TRUE(got.has_value());
+        EXPECT_EQ(got->timestamp, o.timestamp);
+        EXPECT_EQ(got->order_id, o.order_id);
+        EXPECT_EQ(got->instrument, o.instrument);
+        EXPECT_EQ(got->side, o.side);
+        EXPECT_EQ(got->type, o.type);
+        EXPECT_EQ(got->action, o.action);
+        EXPECT_EQ(got->quantity, o.quantity);
+        EXPECT_EQ(got->price, o.price);   // égalité exacte
+    }
+    EXPECT_FALSE(r.next().has_value());
+    std::remove(path.c_str());
+}
+
+TEST(BinaryFormat, ResultsRoundTrip) {
+    const std::string path = "tests/data/tmp_results.bin";
+    MatchResult in{ 5, 6, "TSLA", Side::SELL, Type::LIMIT, 10, 599.5, Action::NEW,
+                    Status::PARTIALLY_EXECUTED, 50, 600.0, 9 };
+    {
+        BinaryResultWriter w(path);
+        w.write(in);
+    }
+    BinaryResultReader r(path);
+    ASSERT_EQ(r.size(), 1u);
+    MatchResult out = r.at(0);
+    EXPECT_EQ(out.instrument, "TSLA");
+    EXPECT_EQ(out.status, Status::PARTIALLY_EXECUTED);
+    EXPECT_EQ(out.price, 599.5);
+    EXPECT_EQ(out.execution_price, 600.0);
+    EXPECT_EQ(out.executed_quantity, 50u);
+    EXPECT_EQ(out.counterparty_id, 9u);
+    std::remove(path.c_str());
+}
+
+// Fichier d'un autre type ou tronqué : refusé à l'ouverture
+TEST(BinaryFormat, RejectsForeignOrTruncatedFiles) {
+    EXPECT_THROW(BinaryOrderReader("tests/data/input_valid.csv"), std::runtime_error);
+
+    const std::string path = "tests/data/tmp_truncated.bin";
+    {
+        BinaryOrderWriter w(path);
+        for (uint64_t i = 0; i < 10; ++i)
+            w.write(Order::makeLimit(i, i, "AAPL", Side::BUY, 1, 1.0, Action::NEW));
+    }
+    std::string bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() / 2));
+    }
+    EXPECT_THROW(BinaryOrderReader{path}, std::runtime_error);
+    EXPECT_THROW(BinaryResultReader{path}, std::runtime_error);
+    std::remove(path.c_str());
+}
@@ -146,3 +146,71 @@ TEST(CsvParser, EmptyFileOrOnlyHeader) {
     EXPECT_FALSE(p.next().has_value());
     EXPECT_TRUE(p.getErrors().empty());
 }
+
+// Les modes Mapped et Stream lisent les mêmes ordres et relèvent les mêmes erreurs
+TEST(CsvParser, MappedAndStreamModesAgree) {
+    for (const char* file : { "tests/data/input_valid.csv", "tests/data/input_invalid.csv",
+                              "tests/data/input_all_errors.csv", "tests/data/input_two_valid.csv",
+                              "tests/data/input_few_columns.csv", "tests/data/input_only_header.csv" }) {
+        CsvParser mapped(file, CsvParser::Source::Mapped);
+        CsvParser stream(file, CsvParser::Source::Stream);
+        for (int i = 0; i < 8; ++i) {
+            auto a = mapped.next();
+            auto b = stream.next();
+            ASSERT_EQ(a.has_value(), b.has_value()) << file;
+            if (a) {
+                EXPECT_EQ(a->order_id, b->order_id);
+                EXPECT_EQ(a->instrument, b->instrument);
+                EXPECT_DOUBLE_EQ(a->price, b->price);
+            }
+        }
+        ASSERT_EQ(mapped.getErrors().size(), stream.getErrors().size()) << file;
+        for (size_t i = 0; i < mapped.getErrors().size(); ++i) {
+            EXPECT_EQ(mapped.getErrors()[i].line_number, stream.getErrors()[i].line_number);
+            EXPECT_EQ(mapped.getErrors()[i].message, stream.getErrors()[i].message);
+            EXPECT_EQ(mapped.getErrors()[i].raw_line, stream.getErrors()[i].raw_line);
+        }
+    }
+}
+
+// Un champ numérique doit être entièrement consommé : "12abc" n'est plus lu comme 12
+TEST(CsvParser, RejectsTrailingGarbageInNumbers) {
+    std::vector<ParseError> errors;
+    EXPECT_FALSE(CsvParser::parseLine("1610000000,7x,AAPL,BUY,LIMIT,100,150.25,NEW", 2, errors));
+    EXPECT_FALSE(CsvParser::parseLine("1610000000,8,AAPL,BUY,LIMIT,100,inf,NEW", 3, errors));
+    ASSERT_EQ(errors.size(), 2u);
+    EXPECT_EQ(errors[0].message, "order_id invalide");
+    EXPECT_EQ(errors[0].line_number, 2u);
+    EXPECT_EQ(errors[1].message, "Prix invalide");
+
+    auto o = CsvParser::parseLine("1610000000,9,AAPL,SELL,LIMIT,5,99.5,NEW", 4, errors);
+    ASSERT_TRUE(o.has_value());
+    EXPECT_DOUBLE_EQ(o->price, 99.5);
+    EXPECT_EQ(errors.size(), 2u);
+}
+
+// Comme std::stoull / std::stod avant from_chars : blancs autour des nombres et '+'
+// explicite acceptés ; un signe ambigu ou négatif reste rejeté
+TEST(CsvParser, AcceptsSurroundingBlanksAndExplicitPlus) {
+    std::vector<ParseError> errors;
+    auto a = CsvParser::parseLine("1610000000,1,AAPL,BUY,LIMIT, 10,100.5,NEW", 2, errors);
+    auto b = CsvParser::parseLine("1610000000,2,AAPL,BUY,LIMIT,+10,+100.5,NEW", 3, errors);
+    auto c = CsvParser::parseLine(" 1610000000,+3,AAPL,SELL,LIMIT,10 , 100.5,NEW", 4, errors);
+    auto d = CsvParser::parseLine("1610000000,4,AAPL,SELL,LIMIT,10,100.5 ,NEW", 5, errors);
+    for (const auto* o : { &a, &b, &c, &d }) {
+        ASSERT_TRUE(o->has_value());
+        EXPECT_EQ((*o)->quantity, 10u);
+        EXPECT_DOUBLE_EQ((*o)->price, 100.5);
+    }
+    EXPECT_EQ(c->timestamp, 1610000000u);
+    EXPECT_EQ(c->order_id, 3u);
+    EXPECT_TRUE(errors.empty());
+
+    EXPECT_FALSE(CsvParser::parseLine("1610000000,5,AAPL,BUY,LIMIT,10,+-100.5,NEW", 6, errors));
+    EXPECT_FALSE(CsvParser::parseLine("1610000000,6,AAPL,BUY,LIMIT, -10,100.5,NEW", 7, errors));
+    EXPECT_FALSE(CsvParser::parseLine("1610000000,7,AAPL,BUY,LIMIT,++10,100.5,NEW", 8, errors));
+    ASSERT_EQ(errors.size(), 3u);
+    EXPECT_EQ(errors[0].message, "Prix invalide");
+    EXPECT_EQ(errors[1].message, "Quantité négative");
+    EXPECT_EQ(errors[2].message, "Quantité invalide");
+}
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+#include "CsvScanner.h"
+
+using namespace me;
+
+namespace {
+    const CsvScanner::Kernel kKernels[] = {
+        CsvScanner::Kernel::Scalar, CsvScanner::Kernel::Sse2, CsvScanner::Kernel::Avx2
+    };
+
+    std::string randomText(size_t n, unsigned seed) {
+        std::mt19937 rng{seed};
+        const char alphabet[] = "0123456789.,,\n\nABCD-\r\x80\xff";
+        std::string s(n, ' ');
+        for (auto& c : s)
+            c = alphabet[rng() % (sizeof(alphabet) - 1)];
+        return s;
+    }
+}
+
+// Tous les noyaux supportés produisent le même masque que la référence scalaire
+TEST(CsvScanner, KernelsAgreeOnMasks) {
+    std::string text = randomText(64 * 200, 1);
+    for (auto k : kKernels) {
+        if (!CsvScanner::supported(k)) continue;
+        for (size_t b = 0; b < text.size(); b += 64)
+            ASSERT_EQ(CsvScanner::delimiterMask(text.data() + b, k),
+                      CsvScanner::delimiterMask(text.data() + b, CsvScanner::Kernel::Scalar))
+                << CsvScanner::name(k) << " bloc " << b / 64;
+    }
+}
+
+// Les positions renvoyées par next() sont exactement celles des ',' et '\n', y compris
+// dans un dernier bloc incomplet et après seek()
+TEST(CsvScanner, FindsEveryDelimiterInOrder) {
+    std::string text = randomText(1000, 2);   // 1000 n'est pas multiple de 64
+    std::vector<size_t> expected;
+    for (size_t i = 0; i < text.size(); ++i)
+        if (text[i] == ',' || text[i] == '\n') expected.push_back(i);
+
+    for (auto k : kKernels) {
+        CsvScanner s(text, k);
+        std::vector<size_t> got;
+        for (size_t p; (p = s.next()) < text.size();)
+            got.push_back(p);
+        EXPECT_EQ(got, expected) << CsvScanner::name(s.kernel());
+
+        s.seek(333);
+        size_t first = s.next();
+        auto   it    = std::lower_bound(expected.begin(), expected.end(), size_t{333});
+        EXPECT_EQ(first, it == expected.end() ? text.size() : *it);
+    }
+}
+
+TEST(CsvScanner, EmptyTextHasNoDelimiter) {
+    CsvScanner s(std::string_view{});
+    EXPECT_EQ(s.next(), 0u);
+}
@@ -137,4 +137,34 @@ TEST(CsvWriter, WritesCorrectStatusForCancelOrRejected) {
     ASSERT_EQ(lines.size(), 3u);
     EXPECT_NE(lines.at(1).find("CANCELED"), std::string::npos);
     EXPECT_NE(lines.at(2).find("REJECTED"), std::string::npos);
-}
\ No newline at end of file
+}
+
+// 6) Prix en virgule fixe sans perte de précision ni notation exponentielle
+TEST(CsvWriter, FormatsLargePricesWithoutExponent) {
+    const std::string out = "tests/data/tmp_fixed.csv";
+    {
+        CsvWriter w(out);
+        MatchResult r{18446744073709551615ull, 7, "FFF", Side::SELL, Type::LIMIT, 3, 1234567.25,
+                      Action::MODIFY, Status::PARTIALLY_EXECUTED, 2, 0.00000001, 9};
+        w.write(r);
+    }
+    auto lines = readAllLines(out);
+    ASSERT_EQ(lines.size(), 2u);
+    EXPECT_EQ(lines.at(1),
+        "18446744073709551615,7,FFF,SELL,LIMIT,3,1234567.25,MODIFY,PARTIALLY_EXECUTED,2,0.00000001,9");
+}
+
+// 7) Ordres au format d'entrée, relisibles par CsvParser
+TEST(CsvOrderWriter, WritesInputFormat) {
+    const std::string out = "tests/data/tmp_orders.csv";
+    {
+        CsvOrderWriter w(out);
+        w.write(Order::makeLimit(1617278400000000000ull, 1, "AAPL", Side::BUY, 100, 150.25, Action::NEW));
+        w.write(Order::makeMarket(1617278400000001000ull, 2, "GOOG", Side::SELL, 10, Action::NEW));
+    }
+    auto lines = readAllLines(out);
+    ASSERT_EQ(lines.size(), 3u);
+    EXPECT_EQ(lines.at(0), "timestamp,order_id,instrument,side,type,quantity,price,action");
+    EXPECT_EQ(lines.at(1), "1617278400000000000,1,AAPL,BUY,LIMIT,100,150.25,NEW");
+    EXPECT_EQ(lines.at(2), "1617278400000001000,2,GOOG,SELL,MARKET,10,0,NEW");
+}
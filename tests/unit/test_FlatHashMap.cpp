@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <unordered_map>
+#include "FlatHashMap.h"
+
+using namespace me;
+
+// Insertion, lecture et suppression de base
+TEST(FlatHashMap, InsertFindErase) {
+    FlatHashMap<uint64_t> m;
+    m[0]  = 10;
+    m[42] = 20;
+    ASSERT_NE(m.find(0), nullptr);
+    EXPECT_EQ(*m.find(0), 10u);
+    EXPECT_EQ(*m.find(42), 20u);
+    EXPECT_EQ(m.find(7), nullptr);
+    EXPECT_TRUE(m.erase(0));
+    EXPECT_FALSE(m.erase(0));
+    EXPECT_EQ(m.find(0), nullptr);
+    EXPECT_EQ(m.size(), 1u);
+}
+
+// La suppression par backward shift garde toutes les chaînes de sondage joignables
+TEST(FlatHashMap, MatchesReferenceUnderChurn) {
+    FlatHashMap<uint64_t> m;
+    std::unordered_map<uint64_t, uint64_t> ref;
+    std::mt19937_64 rng{11};
+    std::uniform_int_distribution<uint64_t> key{0, 5000};
+    for (int i = 0; i < 200000; ++i) {
+        uint64_t k = key(rng);
+        if (rng() % 3 == 0) {
+            EXPECT_EQ(m.erase(k), ref.erase(k) == 1);
+        } else {
+            m[k]   = k * 3 + static_cast<uint64_t>(i);
+            ref[k] = k * 3 + static_cast<uint64_t>(i);
+        }
+    }
+    ASSERT_EQ(m.size(), ref.size());
+    for (auto const& [k, v] : ref) {
+        ASSERT_NE(m.find(k), nullptr);
+        EXPECT_EQ(*m.find(k), v);
+    }
+}
+
+// reserve() dimensionne la table une fois pour toutes
+TEST(FlatHashMap, ReserveKeepsCapacity) {
+    FlatHashMap<uint64_t> m;
+    m.reserve(1000);
+    m[1] = 1;
+    auto* slot = m.find(1);
+    for (uint64_t k = 2; k <= 1000; ++k) m[k] = k;
+    EXPECT_EQ(m.find(1), slot);   // pas de rehash : l'entrée n'a pas bougé
+}
@@ -0,0 +1,282 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+#include "Journal.h"
+#include "Logger.h"
+#include "MatchingEngine.h"
+#include "OrderFlowGenerator.h"
+
+using namespace me;
+namespace fs = std::filesystem;
+
+namespace {
+
+    // Répertoire de journal vide, supprimé en fin de test
+    struct TempDir {
+        explicit TempDir(const std::string& name) : path("tests/data/tmp_journal_" + name) {
+            fs::remove_all(path);
+        }
+        ~TempDir() { fs::remove_all(path); }
+        std::string path;
+    };
+
+    std::vector<Order> sampleFlow(size_t n) {
+        OrderFlowGenerator::Options opts;
+        opts.instruments = 7;
+        OrderFlowGenerator gen(opts);
+        std::vector<Order> out;
+        for (size_t i = 0; i < n; ++i)
+            out.push_back(gen.next());
+        return out;
+    }
+
+    std::vector<Order> replayAll(const std::string& dir, std::vector<uint64_t>* seqs = nullptr) {
+        std::vector<Order> out;
+        Journal::replay(dir, [&](uint64_t seq, const Order& o) {
+            out.push_back(o);
+            if (seqs) seqs->push_back(seq);
+        });
+        return out;
+    }
+
+    void expectSameOrder(const Order& a, const Order& b) {
+        EXPECT_EQ(a.timestamp,  b.timestamp);
+        EXPECT_EQ(a.order_id,   b.order_id);
+        EXPECT_EQ(a.instrument, b.instrument);
+        EXPECT_EQ(a.side,       b.side);
+        EXPECT_EQ(a.type,       b.type);
+        EXPECT_EQ(a.quantity,   b.quantity);
+        EXPECT_DOUBLE_EQ(a.price, b.price);
+        EXPECT_EQ(a.action,     b.action);
+    }
+
+    std::string lastSegment(const std::string& dir) {
+        std::string last;
+        for (const auto& e : fs::directory_iterator(dir))
+            last = std::max(last, e.path().string());
+        return last;
+    }
+}
+
+// Chaque niveau de durabilité écrit le même journal, relu à l'identique
+TEST(Journal, AppendThenReplayForEveryDurability) {
+    auto flow = sampleFlow(1000);
+    for (auto d : { Journal::Durability::None, Journal::Durability::Async,
+                    Journal::Durability::Group, Journal::Durability::Sync }) {
+        TempDir dir(std::string("durability_") + toString(d));
+        {
+            Journal::Options opts;
+            opts.durability = d;
+            opts.intervalUs = 100;
+            Journal j(dir.path, opts);
+            for (size_t i = 0; i < flow.size(); ++i)
+                ASSERT_EQ(j.append(flow[i]), i + 1);
+        }
+        std::vector<uint64_t> seqs;
+        auto back = replayAll(dir.path, &seqs);
+        ASSERT_EQ(back.size(), flow.size()) << toString(d);
+        for (size_t i = 0; i < flow.size(); ++i) {
+            EXPECT_EQ(seqs[i], i + 1);
+            expectSameOrder(back[i], flow[i]);
+        }
+    }
+}
+
+// Group commit : un msync par lot de groupSize ordres, plus ceux de commit()
+TEST(Journal, GroupCommitBatchesSyncs) {
+    TempDir dir("group");
+    Journal::Options opts;
+    opts.durability = Journal::Durability::Group;
+    opts.groupSize  = 16;
+    Journal j(dir.path, opts);
+    uint64_t atOpen = j.syncs();   // en-tête et préallocation du premier segment
+    for (const auto& o : sampleFlow(160))
+        j.append(o);
+    EXPECT_EQ(j.syncs() - atOpen, 10u);
+    j.commit();
+    EXPECT_EQ(j.syncs() - atOpen, 10u);   // rien en attente
+}
+
+// Réouverture : le journal reprend après son dernier ordre
+TEST(Journal, ReopenContinuesSequence) {
+    TempDir dir("reopen");
+    auto flow = sampleFlow(30);
+    {
+        Journal j(dir.path);
+        for (size_t i = 0; i < 20; ++i) j.append(flow[i]);
+    }
+    {
+        Journal j(dir.path);
+        EXPECT_EQ(j.nextSequence(), 21u);
+        for (size_t i = 20; i < 30; ++i) EXPECT_EQ(j.append(flow[i]), i + 1);
+    }
+    auto back = replayAll(dir.path);
+    ASSERT_EQ(back.size(), flow.size());
+    for (size_t i = 0; i < flow.size(); ++i)
+        expectSameOrder(back[i], flow[i]);
+}
+
+// Petits segments : bascule vers un nouveau segment, dictionnaire repris à chaque fois
+TEST(Journal, RollsOverSegments) {
+    TempDir dir("rollover");
+    auto flow = sampleFlow(2000);
+    {
+        Journal::Options opts;
+        opts.segmentBytes = 4096;
+        Journal j(dir.path, opts);
+        for (const auto& o : flow) j.append(o);
+        EXPECT_GT(j.segments(), 20u);
+    }
+    {
+        // reprise sur le dernier segment, puis bascule à nouveau
+        Journal::Options opts;
+        opts.segmentBytes = 4096;
+        Journal j(dir.path, opts);
+        EXPECT_EQ(j.nextSequence(), flow.size() + 1);
+        for (const auto& o : flow) j.append(o);
+    }
+    auto back = replayAll(dir.path);
+    ASSERT_EQ(back.size(), 2 * flow.size());
+    for (size_t i = 0; i < back.size(); ++i)
+        expectSameOrder(back[i], flow[i % flow.size()]);
+}
+
+// Fin de journal abîmée (écriture interrompue) : ignorée à la relecture, puis
+// écrasée par les ajouts suivants
+TEST(Journal, TornTailIsDiscarded) {
+    TempDir dir("torn");
+    auto flow = sampleFlow(12);
+    {
+        Journal j(dir.path);
+        for (size_t i = 0; i < 10; ++i) j.append(flow[i]);
+    }
+    // on abîme l'avant-dernier enregistrement : le dernier, intact, doit être ignoré lui aussi
+    std::string segment = lastSegment(dir.path);
+    std::vector<uint64_t> seqs;
+    replayAll(dir.path, &seqs);
+    ASSERT_EQ(seqs.size(), 10u);
+    {
+        std::fstream f(segment, std::ios::in | std::ios::out | std::ios::binary);
+        // en-tête, symboles et ordres mêlés : on cherche l'enregistrement de l'ordre 9
+        std::vector<char> bytes(64 * 32);
+        f.read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        size_t target = 0;
+        for (size_t pos = 64; pos + 64 <= bytes.size(); pos += 64)
+            if (bytes[pos] == 1 && static_cast<unsigned char>(bytes[pos + 8]) == 9) target = pos;
+        ASSERT_NE(target, 0u);
+        f.seekp(static_cast<std::streamoff>(target + 20));
+        f.put(static_cast<char>(bytes[target + 20] ^ 0x5a));
+    }
+    EXPECT_EQ(replayAll(dir.path).size(), 8u);
+
+    {
+        Journal j(dir.path);
+        EXPECT_EQ(j.nextSequence(), 9u);
+        EXPECT_EQ(j.append(flow[10]), 9u);
+        EXPECT_EQ(j.append(flow[11]), 10u);
+    }
+    auto back = replayAll(dir.path);
+    ASSERT_EQ(back.size(), 10u);
+    expectSameOrder(back[8], flow[10]);
+    expectSameOrder(back[9], flow[11]);
+}
+
+// Page perdue au milieu de la fin (none / async) : un enregistrement effacé suivi
+// d'enregistrements valides. Ces derniers sont obsolètes : effacés à la réouverture,
+// ils ne sont jamais relus comme la suite du journal.
+TEST(Journal, StaleRecordsBeyondAHoleAreDiscarded) {
+    TempDir dir("hole");
+    std::vector<Order> flow;
+    for (uint64_t i = 1; i <= 12; ++i)
+        flow.push_back(Order::makeLimit(i, i, "AAPL", i % 2 ? Side::BUY : Side::SELL,
+                                        10 + i, 100.0 + static_cast<double>(i), Action::NEW));
+    {
+        Journal::Options opts;
+        opts.durability = Journal::Durability::None;
+        Journal j(dir.path, opts);
+        for (size_t i = 0; i < 10; ++i) j.append(flow[i]);
+    }
+    std::string segment = lastSegment(dir.path);
+    {
+        std::fstream f(segment, std::ios::in | std::ios::out | std::ios::binary);
+        std::vector<char> bytes(64 * 16);
+        f.read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        size_t target = 0;
+        for (size_t pos = 64; pos + 64 <= bytes.size(); pos += 64)
+            if (bytes[pos] == 1 && static_cast<unsigned char>(bytes[pos + 8]) == 7) target = pos;
+        ASSERT_NE(target, 0u);
+        // l'ordre 9, deux enregistrements plus loin, reste intact
+        ASSERT_EQ(bytes[target + 128], 1);
+        ASSERT_EQ(static_cast<unsigned char>(bytes[target + 128 + 8]), 9);
+        f.seekp(static_cast<std::streamoff>(target));
+        const std::vector<char> zeros(64, 0);
+        f.write(zeros.data(), static_cast<std::streamsize>(zeros.size()));
+    }
+    EXPECT_EQ(replayAll(dir.path).size(), 6u);
+
+    {
+        Journal j(dir.path);
+        EXPECT_EQ(j.nextSequence(), 7u);
+        EXPECT_EQ(j.append(flow[10]), 7u);
+    }
+    std::vector<uint64_t> seqs;
+    auto back = replayAll(dir.path, &seqs);
+    ASSERT_EQ(back.size(), 7u);
+    EXPECT_EQ(seqs.back(), 7u);
+    expectSameOrder(back[6], flow[10]);
+
+    {
+        Journal j(dir.path);
+        EXPECT_EQ(j.append(flow[11]), 8u);
+    }
+    back = replayAll(dir.path);
+    ASSERT_EQ(back.size(), 8u);
+    expectSameOrder(back[7], flow[11]);
+}
+
+// Rejouer le journal dans un moteur neuf redonne les mêmes carnets : les ordres
+// suivants produisent les mêmes résultats que sur le moteur d'origine
+TEST(Journal, ReplayRebuildsEngineState) {
+    setLoggingEnabled(false);
+    TempDir dir("engine");
+    OrderFlowGenerator gen;
+    MatchingEngine     original;
+    gen.registerInstruments(original);
+    auto observe = [&](const MatchResult& r) { gen.observe(r); };
+    {
+        Journal j(dir.path);
+        for (int i = 0; i < 20000; ++i) {
+            Order o = gen.next();
+            j.append(o);
+            original.process(o, observe);
+        }
+    }
+
+    MatchingEngine recovered;
+    gen.registerInstruments(recovered);
+    auto replayed = Journal::replay(dir.path, [&](uint64_t, const Order& o) {
+        recovered.process(o, [](const MatchResult&) {});
+    });
+    EXPECT_EQ(replayed, 20000u);
+
+    for (int i = 0; i < 5000; ++i) {
+        Order o = gen.next();
+        std::vector<MatchResult> a, b;
+        original.process(o, [&](const MatchResult& r) { a.push_back(r); gen.observe(r); });
+        recovered.process(o, [&](const MatchResult& r) { b.push_back(r); });
+        ASSERT_EQ(a.size(), b.size()) << "ordre " << i;
+        for (size_t k = 0; k < a.size(); ++k) {
+            EXPECT_EQ(a[k].order_id, b[k].order_id);
+            EXPECT_EQ(a[k].status, b[k].status);
+            EXPECT_EQ(a[k].executed_quantity, b[k].executed_quantity);
+            EXPECT_EQ(a[k].counterparty_id, b[k].counterparty_id);
+        }
+    }
+}
+
+TEST(Journal, MissingDirectoryReplaysNothing) {
+    EXPECT_EQ(Journal::replay("tests/data/tmp_journal_absent", [](uint64_t, const Order&) {}), 0u);
+    EXPECT_THROW(Journal::parseDurability("fsync"), std::runtime_error);
+    EXPECT_EQ(Journal::parseDurability("group"), Journal::Durability::Group);
+}
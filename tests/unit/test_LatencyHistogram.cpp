@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <sstream>
+#include "LatencyHistogram.h"
+
+using namespace me;
+
+// Classes contiguës : chaque valeur tombe dans sa classe, bornes comprises
+TEST(LatencyHistogram, BucketsCoverEveryValue) {
+    const uint64_t samples[] = { 0, 1, 127, 128, 129, 255, 256, 1000, 123456789,
+                                 (uint64_t{1} << 40) + 12345, UINT64_MAX };
+    for (uint64_t v : samples) {
+        size_t i = LatencyHistogram::indexOf(v);
+        ASSERT_LT(i, LatencyHistogram::kBuckets) << v;
+        EXPECT_GE(LatencyHistogram::highestIn(i), v);
+        if (i > 0) {
+            EXPECT_LT(LatencyHistogram::highestIn(i - 1), v);
+        }
+    }
+    for (size_t i = 1; i < LatencyHistogram::kBuckets; ++i)
+        ASSERT_EQ(LatencyHistogram::indexOf(LatencyHistogram::highestIn(i - 1) + 1), i);
+}
+
+// Percentiles à moins de 1/64 près de la valeur exacte
+TEST(LatencyHistogram, PercentilesWithinRelativePrecision) {
+    std::mt19937_64 rng{5};
+    std::lognormal_distribution<double> dist{7.0, 1.5};
+    std::vector<uint64_t> values;
+    LatencyHistogram      h;
+    for (int i = 0; i < 200000; ++i) {
+        auto v = static_cast<uint64_t>(dist(rng));
+        values.push_back(v);
+        h.record(v);
+    }
+    std::sort(values.begin(), values.end());
+    for (double p : { 50.0, 90.0, 99.0, 99.9, 99.99 }) {
+        auto   rank  = static_cast<size_t>(std::ceil(p / 100.0 * values.size()));
+        double exact = static_cast<double>(values[rank - 1]);
+        double got   = static_cast<double>(h.percentile(p));
+        EXPECT_GE(got, exact) << p;
+        EXPECT_LE(got, exact * (1.0 + 1.0 / 64) + 1) << p;
+    }
+    EXPECT_EQ(h.percentile(100.0), values.back());
+    EXPECT_EQ(h.min(), values.front());
+    EXPECT_EQ(h.count(), values.size());
+}
+
+TEST(LatencyHistogram, MergeAndReset) {
+    LatencyHistogram a, b;
+    for (uint64_t v = 1; v <= 100; ++v) a.record(v);
+    for (uint64_t v = 1001; v <= 1100; ++v) b.record(v);
+    a.merge(b);
+    EXPECT_EQ(a.count(), 200u);
+    EXPECT_EQ(a.min(), 1u);
+    EXPECT_EQ(a.max(), 1100u);
+    EXPECT_EQ(a.percentile(50.0), 100u);
+    EXPECT_DOUBLE_EQ(a.mean(), (5050.0 + 105050.0) / 200);
+
+    std::ostringstream os;
+    a.print(os, "total");
+    EXPECT_NE(os.str().find("total"), std::string::npos);
+
+    a.reset();
+    EXPECT_EQ(a.count(), 0u);
+    EXPECT_EQ(a.percentile(99.0), 0u);
+}
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Logger.h"
+#include "Order.h"
+
+using namespace me;
+
+namespace {
+    // Redirige std::cout le temps d'un test
+    class CaptureCout {
+    public:
+        CaptureCout() : old_(std::cout.rdbuf(buf_.rdbuf())) {}
+        ~CaptureCout() { std::cout.rdbuf(old_); }
+        std::string text() const { return buf_.str(); }
+    private:
+        std::ostringstream buf_;
+        std::streambuf*    old_;
+    };
+
+    std::vector<std::string> lines(const std::string& text) {
+        std::vector<std::string> out;
+        std::istringstream       in(text);
+        for (std::string l; std::getline(in, l);) out.push_back(l);
+        return out;
+    }
+
+    int evaluations = 0;
+    int counted(int v) { ++evaluations; return v; }
+
+    // Partie message d'une ligne, après « date heure.ms NIVEAU »
+    std::string message(const std::string& line) {
+        auto sp = line.find(' ', line.find(' ') + 1);
+        return line.substr(line.find(' ', sp + 1) + 1);
+    }
+}
+
+// Mode synchrone : arguments substitués dans l'ordre, enums par toString, niveau et horodatage
+TEST(Logger, FormatsArgumentsSynchronously) {
+    if (!logCompiled(LogLevel::INFO)) GTEST_SKIP() << "INFO exclu à la compilation";
+    setLoggingEnabled(true);
+    CaptureCout capture;
+    LOG_WARN("id={} side={} px={} ok={} sym={} s={}", uint64_t{42}, Side::BUY, 101.5, true,
+             Symbol("LOGX"), std::string("abc"));
+    LOG_INFO("sans argument");
+
+    auto out = lines(capture.text());
+    ASSERT_EQ(out.size(), 2u);
+    EXPECT_EQ(message(out[0]), "id=42 side=BUY px=101.500000 ok=true sym=LOGX s=abc");
+    EXPECT_NE(out[0].find(" WARN "), std::string::npos);
+    EXPECT_EQ(out[0][4], '-');
+    EXPECT_EQ(out[0][19], '.');
+    EXPECT_EQ(message(out[1]), "sans argument");
+}
+
+TEST(Logger, TruncatesOversizedArguments) {
+    if (!logCompiled(LogLevel::ERROR)) GTEST_SKIP() << "ERROR exclu à la compilation";
+    setLoggingEnabled(true);
+    CaptureCout capture;
+    LOG_ERROR("a={} b={}", std::string(1000, 'x'), 7);
+
+    auto out = lines(capture.text());
+    ASSERT_EQ(out.size(), 1u);
+    EXPECT_LT(out[0].size(), 400u);
+    EXPECT_NE(out[0].find("[tronqué]"), std::string::npos);
+}
+
+TEST(Logger, DisabledLoggingWritesNothing) {
+    setLoggingEnabled(false);
+    CaptureCout capture;
+    LOG_INFO("rien {}", 1);
+    setLoggingEnabled(true);
+    EXPECT_TRUE(capture.text().empty());
+}
+
+// Niveau coupé (ou logs désactivés) : les arguments ne sont même pas évalués
+TEST(Logger, DisabledLevelSkipsArgumentEvaluation) {
+    CaptureCout capture;
+    evaluations = 0;
+    setLogLevelEnabled(LogLevel::INFO, false);
+    LOG_INFO("coupé {}", counted(1));
+    setLogLevelEnabled(LogLevel::INFO, true);
+
+    setLoggingEnabled(false);
+    LOG_ERROR("coupé {}", counted(2));
+    setLoggingEnabled(true);
+
+    EXPECT_EQ(evaluations, 0);
+    EXPECT_TRUE(capture.text().empty());
+}
+
+TEST(Logger, PerLevelSwitches) {
+    if (!logCompiled(LogLevel::INFO)) GTEST_SKIP() << "INFO exclu à la compilation";
+    setLoggingEnabled(true);
+    CaptureCout capture;
+    setLogLevelEnabled(LogLevel::INFO, false);
+    LOG_INFO("info {}", 1);
+    LOG_WARN("warn {}", 2);
+    setLogLevelEnabled(LogLevel::INFO, true);
+    LOG_INFO("info {}", 3);
+
+    auto out = lines(capture.text());
+    ASSERT_EQ(out.size(), 2u);
+    EXPECT_EQ(message(out[0]), "warn 2");
+    EXPECT_EQ(message(out[1]), "info 3");
+    EXPECT_TRUE(logEnabled(LogLevel::INFO));
+}
+
+// Mode asynchrone : aucun message perdu (petits anneaux, producteurs bloqués)
+// et l'ordre de chaque thread est conservé
+TEST(Logger, AsyncKeepsEveryMessageInPerThreadOrder) {
+    if (!logCompiled(LogLevel::INFO)) GTEST_SKIP() << "INFO exclu à la compilation";
+    setLoggingEnabled(true);
+    constexpr int kThreads = 4, kMessages = 1000;
+    CaptureCout capture;
+    {
+        AsyncLogging logging(64);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreads; ++t)
+            threads.emplace_back([t] {
+                for (int i = 0; i < kMessages; ++i)
+                    LOG_INFO("t={} i={}", t, i);
+            });
+        for (auto& th : threads) th.join();
+    }
+
+    std::vector<int> next(kThreads, 0);
+    for (auto const& l : lines(capture.text())) {
+        int t = -1, i = -1;
+        ASSERT_EQ(std::sscanf(message(l).c_str(), "t=%d i=%d", &t, &i), 2) << l;
+        ASSERT_GE(t, 0);
+        ASSERT_LT(t, kThreads);
+        EXPECT_EQ(i, next[t]++);
+    }
+    for (int t = 0; t < kThreads; ++t)
+        EXPECT_EQ(next[t], kMessages);
+}
@@ -91,6 +91,41 @@ TEST(MatchingEngine, ModifyOrderAffectsMatching) {
     EXPECT_EQ(fills.at(0).status, Status::PARTIALLY_EXECUTED);
 }
 
+// MODIFY successifs qui ramènent le remaining à 0 : l'ordre repose toujours dans
+// le carnet (avec la quantité du dernier MODIFY), il doit rester suivi et accepter
+// le MODIFY suivant
+TEST(MatchingEngine, ModifyClampedToZeroStaysTracked) {
+    MatchingEngine eng;
+    auto placed = eng.process(Order::makeLimit(1, 1, "MSFT", Side::BUY, 10, 100.0, Action::NEW));
+    ASSERT_EQ(placed.size(), 1u);
+    EXPECT_EQ(placed.at(0).quantity, 10u);
+
+    // remaining 10 + (5 - 10) = 5
+    auto first = eng.process(Order::makeLimit(2, 1, "MSFT", Side::BUY, 5, 100.0, Action::MODIFY));
+    ASSERT_EQ(first.size(), 1u);
+    EXPECT_EQ(first.at(0).status, Status::PENDING);
+    EXPECT_EQ(first.at(0).quantity, 5u);
+
+    // remaining 5 + (4 - 10) ramené à 0 ; le carnet garde 4 au repos
+    auto second = eng.process(Order::makeLimit(3, 1, "MSFT", Side::BUY, 4, 100.0, Action::MODIFY));
+    ASSERT_EQ(second.size(), 1u);
+    EXPECT_EQ(second.at(0).status, Status::PENDING);
+    EXPECT_EQ(second.at(0).quantity, 0u);
+
+    auto third = eng.process(Order::makeLimit(4, 1, "MSFT", Side::BUY, 6, 100.0, Action::MODIFY));
+    ASSERT_EQ(third.size(), 1u);
+    EXPECT_EQ(third.at(0).status, Status::PENDING);
+    EXPECT_EQ(third.at(0).quantity, 0u);
+
+    // le carnet garde 6 au repos pour l'ordre 1
+    auto fills = eng.process(Order::makeLimit(5, 2, "MSFT", Side::SELL, 10, 100.0, Action::NEW));
+    ASSERT_EQ(fills.size(), 1u);
+    EXPECT_EQ(fills.at(0).counterparty_id, 1u);
+    EXPECT_EQ(fills.at(0).executed_quantity, 6u);
+    EXPECT_EQ(fills.at(0).quantity, 4u);
+    EXPECT_EQ(fills.at(0).status, Status::PARTIALLY_EXECUTED);
+}
+
 // Test d’annulation d’un ordre empêchant tout futur matching
 TEST(MatchingEngine, CancelOrderPreventsMatching) {
     MatchingEngine eng;
@@ -103,4 +138,77 @@ TEST(MatchingEngine, CancelOrderPreventsMatching) {
     // Pas de fills → un résultat PENDING pour le SELL
     ASSERT_EQ(fills.size(), 1u);
     EXPECT_EQ(fills.at(0).status, Status::PENDING);
-}
\ No newline at end of file
+}
+
+// Instrument référencé : carnet dense, prix hors bande → REJECTED sans toucher au carnet
+TEST(MatchingEngine, RegisteredInstrumentRejectsOutOfBandPrice) {
+    MatchingEngine eng;
+    eng.registerInstrument("NVDA", InstrumentSpec{0.01, 100.0, 200.0});
+    auto r = eng.process(Order::makeLimit(1, 1, "NVDA", Side::SELL, 10, 250.0, Action::NEW));
+    ASSERT_EQ(r.size(), 1u);
+    EXPECT_EQ(r.at(0).status, Status::REJECTED);
+
+    eng.process(Order::makeLimit(2, 2, "NVDA", Side::SELL, 10, 150.25, Action::NEW));
+    auto fills = eng.process(Order::makeLimit(3, 3, "NVDA", Side::BUY, 10, 150.30, Action::NEW));
+    ASSERT_EQ(fills.size(), 1u);
+    EXPECT_EQ(fills.at(0).counterparty_id, 2u);
+    EXPECT_DOUBLE_EQ(fills.at(0).execution_price, 150.25);
+    EXPECT_EQ(fills.at(0).status, Status::EXECUTED);
+}
+
+// L'état d'un ordre est libéré dès qu'il est terminé : la table reste bornée
+TEST(MatchingEngine, TerminalOrdersLeaveStateTable) {
+    MatchingEngine eng;
+    eng.process(Order::makeLimit(1, 1, "AAPL", Side::SELL, 10, 100.0, Action::NEW));
+    eng.process(Order::makeLimit(2, 2, "AAPL", Side::SELL, 10, 101.0, Action::NEW));
+    EXPECT_EQ(eng.liveOrders(), 2u);
+
+    // BUY 15 : exécute entièrement 1 (sort de la table), 2 reste partiellement
+    eng.process(Order::makeLimit(3, 3, "AAPL", Side::BUY, 15, 101.0, Action::NEW));
+    EXPECT_EQ(eng.liveOrders(), 1u);
+
+    // MARKET sans contrepartie suffisante : ne repose jamais
+    eng.process(Order::makeMarket(4, 4, "AAPL", Side::BUY, 50, Action::NEW));
+    EXPECT_EQ(eng.liveOrders(), 0u);
+
+    eng.process(Order::makeLimit(5, 5, "AAPL", Side::BUY, 10, 90.0, Action::NEW));
+    eng.process(Order::makeLimit(6, 5, "AAPL", Side::BUY, 0, 0.0, Action::CANCEL));
+    EXPECT_EQ(eng.liveOrders(), 0u);
+}
+
+// MODIFY sur un ordre déjà exécuté : REJECTED, sans effet sur le carnet
+TEST(MatchingEngine, ModifyAfterExecutionIsRejected) {
+    MatchingEngine eng;
+    eng.process(Order::makeLimit(1, 1, "AAPL", Side::SELL, 10, 100.0, Action::NEW));
+    eng.process(Order::makeLimit(2, 2, "AAPL", Side::BUY, 10, 100.0, Action::NEW));
+    auto r = eng.process(Order::makeLimit(3, 1, "AAPL", Side::SELL, 20, 100.0, Action::MODIFY));
+    ASSERT_EQ(r.size(), 1u);
+    EXPECT_EQ(r.at(0).status, Status::REJECTED);
+    auto f = eng.process(Order::makeLimit(4, 4, "AAPL", Side::BUY, 5, 100.0, Action::NEW));
+    ASSERT_EQ(f.size(), 1u);
+    EXPECT_EQ(f.at(0).status, Status::PENDING);
+}
+
+// Le consommateur reçoit les mêmes résultats, dans le même ordre, que le vecteur
+TEST(MatchingEngine, SinkStreamsSameResultsAsVector) {
+    MatchingEngine a, b;
+    std::vector<Order> flow = {
+        Order::makeLimit (1, 1, "AAPL", Side::SELL, 5, 100.0, Action::NEW),
+        Order::makeLimit (2, 2, "AAPL", Side::SELL, 5, 101.0, Action::NEW),
+        Order::makeLimit (3, 3, "AAPL", Side::BUY, 12, 101.0, Action::NEW),
+        Order::makeMarket(4, 4, "AAPL", Side::SELL, 1, Action::NEW),
+        Order::makeLimit (5, 3, "AAPL", Side::BUY, 0, 0.0, Action::CANCEL),
+    };
+    for (auto const& o : flow) {
+        auto expected = a.process(o);
+        std::vector<MatchResult> streamed;
+        b.process(o, [&](const MatchResult& r) { streamed.push_back(r); });
+        ASSERT_EQ(streamed.size(), expected.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_EQ(streamed[i].status, expected[i].status);
+            EXPECT_EQ(streamed[i].quantity, expected[i].quantity);
+            EXPECT_EQ(streamed[i].executed_quantity, expected[i].executed_quantity);
+            EXPECT_EQ(streamed[i].counterparty_id, expected[i].counterparty_id);
+        }
+    }
+}
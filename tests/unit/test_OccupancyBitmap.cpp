@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include <set>
+#include <random>
+#include "OccupancyBitmap.h"
+
+using namespace me;
+
+// Bitmap vide : aucune recherche n'aboutit
+TEST(OccupancyBitmap, EmptyFindsNothing) {
+    OccupancyBitmap bm(1000);
+    EXPECT_EQ(bm.findNext(0),   OccupancyBitmap::npos);
+    EXPECT_EQ(bm.findPrev(999), OccupancyBitmap::npos);
+}
+
+// Recherche à travers les trois niveaux (bits très éloignés)
+TEST(OccupancyBitmap, FindsAcrossWordsAndLevels) {
+    OccupancyBitmap bm(1 << 20);
+    bm.set(3);
+    bm.set(70000);
+    bm.set(1000000);
+    EXPECT_EQ(bm.findNext(0),       3u);
+    EXPECT_EQ(bm.findNext(4),       70000u);
+    EXPECT_EQ(bm.findNext(70001),   1000000u);
+    EXPECT_EQ(bm.findPrev(999999),  70000u);
+    EXPECT_EQ(bm.findPrev(69999),   3u);
+    bm.clear(70000);
+    EXPECT_FALSE(bm.test(70000));
+    EXPECT_EQ(bm.findNext(4),       1000000u);
+    EXPECT_EQ(bm.findPrev(999999),  3u);
+    bm.clear(3);
+    EXPECT_EQ(bm.findPrev(999999),  OccupancyBitmap::npos);
+}
+
+// Comparaison aléatoire avec un std::set de référence
+TEST(OccupancyBitmap, MatchesReferenceSet) {
+    constexpr size_t N = 300000;
+    OccupancyBitmap bm(N);
+    std::set<size_t> ref;
+    std::mt19937_64 rng{7};
+    std::uniform_int_distribution<size_t> pos{0, N - 1};
+    for (int i = 0; i < 20000; ++i) {
+        size_t p = pos(rng);
+        if (ref.count(p)) { ref.erase(p); bm.clear(p); }
+        else              { ref.insert(p); bm.set(p); }
+
+        size_t q = pos(rng);
+        auto next = ref.lower_bound(q);
+        EXPECT_EQ(bm.findNext(q), next == ref.end() ? OccupancyBitmap::npos : *next);
+        auto prev = ref.upper_bound(q);
+        EXPECT_EQ(bm.findPrev(q), prev == ref.begin() ? OccupancyBitmap::npos : *std::prev(prev));
+    }
+}
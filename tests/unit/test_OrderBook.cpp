@@ -102,4 +102,79 @@ TEST(OrderBook, ResidualOrderRemainsAfterPartialFill) {
     ASSERT_EQ(fills2.size(), 1u);
     EXPECT_EQ(fills2.at(0).executed_quantity, 30u);
     EXPECT_DOUBLE_EQ(fills2.at(0).execution_price, 100.0);
-}
\ No newline at end of file
+}
+
+// CANCEL retrouvé par order_id seul, même si prix et side du message diffèrent
+TEST(OrderBook, CancelByIdIgnoresPriceAndSide) {
+    OrderBook book;
+    book.process(Order::makeLimit(1, 1, "XYZ", Side::SELL, 10, 100.0, Action::NEW));
+    // message CANCEL sans le prix ni le side d'origine
+    book.process(Order::makeLimit(2, 1, "XYZ", Side::BUY, 0, 0.0, Action::CANCEL));
+    EXPECT_TRUE(book.empty());
+}
+
+// Annulation au milieu d'une file : la priorité FIFO des autres ordres est conservée
+TEST(OrderBook, CancelInMiddleOfQueueKeepsFIFO) {
+    OrderBook book;
+    book.process(Order::makeLimit(1, 1, "XYZ", Side::SELL, 10, 100.0, Action::NEW));
+    book.process(Order::makeLimit(2, 2, "XYZ", Side::SELL, 10, 100.0, Action::NEW));
+    book.process(Order::makeLimit(3, 3, "XYZ", Side::SELL, 10, 100.0, Action::NEW));
+    book.process(Order::makeLimit(4, 2, "XYZ", Side::SELL, 0, 0.0, Action::CANCEL));
+    auto fills = book.process(Order::makeLimit(5, 5, "XYZ", Side::BUY, 20, 100.0, Action::NEW));
+    ASSERT_EQ(fills.size(), 2u);
+    EXPECT_EQ(fills.at(0).resting_order_id, 1u);
+    EXPECT_EQ(fills.at(1).resting_order_id, 3u);
+    EXPECT_TRUE(book.empty());
+}
+
+// Échelle de prix dense : même priorité prix-temps que le carnet std::map
+TEST(LadderOrderBook, SweepsLevelsInPriceOrder) {
+    LadderOrderBook book(InstrumentSpec{0.01, 90.0, 110.0});
+    book.process(Order::makeLimit(1, 1, "XYZ", Side::SELL, 10, 100.02, Action::NEW));
+    book.process(Order::makeLimit(2, 2, "XYZ", Side::SELL, 10, 100.01, Action::NEW));
+    book.process(Order::makeLimit(3, 3, "XYZ", Side::SELL, 10, 100.01, Action::NEW));
+    auto fills = book.process(Order::makeLimit(4, 4, "XYZ", Side::BUY, 25, 100.02, Action::NEW));
+    ASSERT_EQ(fills.size(), 3u);
+    EXPECT_EQ(fills.at(0).resting_order_id, 2u);
+    EXPECT_DOUBLE_EQ(fills.at(0).execution_price, 100.01);
+    EXPECT_EQ(fills.at(1).resting_order_id, 3u);
+    EXPECT_EQ(fills.at(2).resting_order_id, 1u);
+    EXPECT_EQ(fills.at(2).executed_quantity, 5u);
+    EXPECT_DOUBLE_EQ(fills.at(2).execution_price, 100.02);
+
+    // le meilleur bid suivant est retrouvé après vidage du niveau
+    book.process(Order::makeLimit(5, 5, "XYZ", Side::BUY, 10, 99.50, Action::NEW));
+    book.process(Order::makeLimit(6, 6, "XYZ", Side::BUY, 10, 99.00, Action::NEW));
+    auto sells = book.process(Order::makeMarket(7, 7, "XYZ", Side::SELL, 15, Action::NEW));
+    ASSERT_EQ(sells.size(), 2u);
+    EXPECT_EQ(sells.at(0).resting_order_id, 5u);
+    EXPECT_EQ(sells.at(1).resting_order_id, 6u);
+    EXPECT_DOUBLE_EQ(sells.at(1).execution_price, 99.0);
+}
+
+// Prix hors bande ou hors pas de cotation refusés par le carnet dense
+TEST(LadderOrderBook, RejectsPricesOutsideBandOrTick) {
+    LadderOrderBook book(InstrumentSpec{0.05, 10.0, 20.0});
+    EXPECT_TRUE (book.accepts(Order::makeLimit(1, 1, "XYZ", Side::BUY, 1, 15.05, Action::NEW)));
+    EXPECT_FALSE(book.accepts(Order::makeLimit(2, 2, "XYZ", Side::BUY, 1, 15.02, Action::NEW)));
+    EXPECT_FALSE(book.accepts(Order::makeLimit(3, 3, "XYZ", Side::BUY, 1, 25.00, Action::NEW)));
+    EXPECT_TRUE (book.accepts(Order::makeMarket(4, 4, "XYZ", Side::BUY, 1, Action::NEW)));
+    EXPECT_THROW(book.process(Order::makeLimit(5, 5, "XYZ", Side::BUY, 1, 9.95, Action::NEW)),
+                 std::invalid_argument);
+}
+
+// Nœuds recyclés : un grand nombre de cycles NEW/CANCEL/fill laisse le carnet cohérent
+TEST(OrderBook, RecyclesNodesAcrossManyCycles) {
+    OrderBook book;
+    book.reserve(64);
+    for (uint64_t round = 0; round < 1000; ++round) {
+        uint64_t id = round * 10;
+        book.process(Order::makeLimit(id,     id,     "XYZ", Side::SELL, 5, 100.0, Action::NEW));
+        book.process(Order::makeLimit(id + 1, id + 1, "XYZ", Side::SELL, 5, 101.0, Action::NEW));
+        book.process(Order::makeLimit(id + 2, id,     "XYZ", Side::SELL, 0, 0.0,   Action::CANCEL));
+        auto fills = book.process(Order::makeLimit(id + 3, id + 3, "XYZ", Side::BUY, 5, 101.0, Action::NEW));
+        ASSERT_EQ(fills.size(), 1u);
+        EXPECT_EQ(fills.at(0).resting_order_id, id + 1);
+        EXPECT_TRUE(book.empty());
+    }
+}
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "OrderFlowGenerator.h"
+#include "Logger.h"
+
+using namespace me;
+
+namespace {
+    bool sameOrder(const Order& a, const Order& b) {
+        return a.timestamp == b.timestamp && a.order_id == b.order_id && a.instrument == b.instrument
+            && a.side == b.side && a.type == b.type && a.quantity == b.quantity
+            && a.price == b.price && a.action == b.action;
+    }
+}
+
+TEST(OrderFlowGenerator, DeterministicForASeed) {
+    OrderFlowGenerator a, b;
+    for (int i = 0; i < 5000; ++i)
+        ASSERT_TRUE(sameOrder(a.next(), b.next())) << i;
+
+    OrderFlowGenerator::Options opts;
+    opts.seed = 7;
+    OrderFlowGenerator c(opts), d;
+    int differences = 0;
+    for (int i = 0; i < 100; ++i)
+        differences += !sameOrder(c.next(), d.next());
+    EXPECT_GT(differences, 0);
+}
+
+// Proportions, popularité de Zipf, prix sur le pas et dans la bande
+TEST(OrderFlowGenerator, FollowsConfiguredShape) {
+    OrderFlowGenerator::Options opts;
+    opts.instruments = 5;
+    OrderFlowGenerator gen(opts);
+    auto spec  = gen.spec();
+    TickScale scale(spec.tick_size);
+
+    constexpr int N = 100000;
+    size_t kinds[OrderFlowGenerator::kKinds] = {};
+    std::vector<size_t> perInstrument(opts.instruments, 0);
+    for (int i = 0; i < N; ++i) {
+        Order o = gen.next();
+        ++kinds[static_cast<size_t>(OrderFlowGenerator::kindOf(o))];
+        ++perInstrument[o.instrument.id() - gen.symbols().front().id()];
+        if (o.type == Type::LIMIT && o.action != Action::CANCEL) {
+            EXPECT_TRUE(scale.onTick(o.price)) << o.price;
+            EXPECT_GE(o.price, spec.min_price);
+            EXPECT_LE(o.price, spec.max_price);
+        }
+    }
+    // sans retour du moteur, aucun ordre ne quitte le carnet que par CANCEL : les ratios sont tenus
+    EXPECT_NEAR(kinds[0] / double(N), opts.newLimit, 0.01);
+    EXPECT_NEAR(kinds[1] / double(N), opts.market,   0.01);
+    EXPECT_NEAR(kinds[2] / double(N), opts.modify,   0.01);
+    EXPECT_NEAR(kinds[3] / double(N), opts.cancel,   0.01);
+    for (size_t k = 1; k < perInstrument.size(); ++k)
+        EXPECT_GT(perInstrument[k - 1], perInstrument[k]) << k;
+}
+
+// Avec le retour du moteur, MODIFY et CANCEL ne visent que des ordres au repos
+TEST(OrderFlowGenerator, TargetsRestingOrdersWhenObserving) {
+    setLoggingEnabled(false);
+    OrderFlowGenerator gen;
+    MatchingEngine     engine;
+    gen.registerInstruments(engine);
+
+    size_t modifies = 0, rejected = 0, fills = 0;
+    for (int i = 0; i < 50000; ++i) {
+        Order o = gen.next();
+        engine.process(o, [&](const MatchResult& r) {
+            gen.observe(r);
+            if (r.executed_quantity > 0) ++fills;
+            if (o.action == Action::MODIFY) {
+                ++modifies;
+                if (r.status == Status::REJECTED) ++rejected;
+            }
+        });
+    }
+    EXPECT_GT(modifies, 0u);
+    EXPECT_GT(fills, 0u);
+    EXPECT_EQ(rejected, 0u);
+    EXPECT_GT(gen.liveOrders(), 0u);
+}
+
+TEST(OrderFlowGenerator, RejectsInvalidOptions) {
+    OrderFlowGenerator::Options opts;
+    opts.instruments = 0;
+    EXPECT_THROW(OrderFlowGenerator{opts}, std::invalid_argument);
+    opts = {};
+    opts.newLimit = opts.market = opts.modify = opts.cancel = 0.0;
+    EXPECT_THROW(OrderFlowGenerator{opts}, std::invalid_argument);
+}
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include "OutputFile.h"
+
+using namespace me;
+
+namespace {
+    std::string readFile(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        return { std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>() };
+    }
+
+    // Écrit des lignes numérotées de longueurs variables, plus un en-tête patché à la fin
+    std::string writeSample(const std::string& path, const OutputFile::Options& opts, uint64_t* stalls = nullptr) {
+        std::string expected = "HEAD";
+        {
+            OutputFile f(path, opts);
+            f.append("....");
+            for (int i = 0; i < 5000; ++i) {
+                std::string line = std::to_string(i) + std::string(i % 37, 'x') + "\n";
+                f.append(line);
+                expected += line;
+            }
+            f.append(std::string(300, 'y'));   // plus grand qu'un tampon de test
+            expected += std::string(300, 'y');
+            f.writeAt(0, "HEAD", 4);
+            if (stalls) *stalls = f.stalls();
+            f.close();
+        }
+        return expected;
+    }
+}
+
+// Les modes synchrone et asynchrone écrivent exactement les mêmes octets,
+// quelle que soit la politique quand l'anneau de tampons est saturé
+TEST(OutputFile, AsyncWritesSameBytesAsSync) {
+    const std::string path = "tests/data/tmp_output.bin";
+
+    OutputFile::Options sync;
+    sync.bufferBytes = 64;
+    std::string expected = writeSample(path, sync);
+    EXPECT_EQ(readFile(path), expected);
+
+    for (auto policy : { OutputFile::Backpressure::Block, OutputFile::Backpressure::Grow }) {
+        OutputFile::Options async;
+        async.bufferBytes  = 64;
+        async.buffers      = 2;
+        async.async        = true;
+        async.durable      = true;
+        async.backpressure = policy;
+        writeSample(path, async);
+        EXPECT_EQ(readFile(path), expected);
+    }
+    std::remove(path.c_str());
+}
+
+TEST(OutputFile, ThrowsWhenFileCannotBeOpened) {
+    EXPECT_THROW(OutputFile("tests/data/no_such_dir/out.csv"), std::runtime_error);
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "ParallelCsvParser.h"
+#include "Logger.h"
+
+using namespace me;
+
+namespace {
+    // Fichier de test : lignes valides entrecoupées de lignes invalides, sans '\n' final
+    std::string writeSample(const std::string& path, size_t lines) {
+        std::ofstream out(path, std::ios::binary);
+        out << "timestamp,order_id,instrument,side,type,quantity,price,action\n";
+        for (size_t i = 0; i < lines; ++i) {
+            if (i % 97 == 13)
+                out << "bad_ts," << i << ",AAPL,BUY,LIMIT,10,100.5,NEW";
+            else if (i % 151 == 7)
+                out << i << "," << i << ",AAPL,BUY";
+            else
+                out << i << "," << i << ",SYM" << i % 5 << (i & 1 ? ",BUY" : ",SELL")
+                    << ",LIMIT," << 1 + i % 40 << "," << 100 + i % 17 << ".25,NEW";
+            if (i + 1 < lines) out << '\n';
+        }
+        return path;
+    }
+}
+
+// Lignes invalides sautées : mêmes ordres, mêmes erreurs et mêmes numéros de ligne
+// que le parser séquentiel, quel que soit le découpage en blocs et le nombre de threads
+TEST(ParallelCsvParser, MatchesSequentialParser) {
+    setLoggingEnabled(false);
+    std::string path = writeSample("tests/data/parallel_sample.csv", 5000);
+
+    CsvParser          seq(path);
+    std::vector<Order> expected;
+    while (true) {
+        size_t before = seq.getErrors().size();
+        auto   o      = seq.next();
+        if (o)                                    expected.push_back(*o);
+        else if (seq.getErrors().size() == before) break;   // fin de fichier
+    }
+    ASSERT_FALSE(seq.getErrors().empty());
+
+    for (size_t chunk : { size_t{1}, size_t{100}, size_t{4096}, size_t{1} << 20 }) {
+        ParallelCsvParser par(path, { 4, chunk, 3, true });
+        std::vector<Order> got;
+        while (auto batch = par.nextBatch())
+            got.insert(got.end(), batch->begin(), batch->end());
+
+        ASSERT_EQ(got.size(), expected.size()) << "bloc " << chunk;
+        for (size_t i = 0; i < got.size(); ++i) {
+            ASSERT_EQ(got[i].order_id, expected[i].order_id);
+            ASSERT_EQ(got[i].instrument, expected[i].instrument);
+            ASSERT_EQ(got[i].quantity, expected[i].quantity);
+        }
+        ASSERT_EQ(par.getErrors().size(), seq.getErrors().size());
+        for (size_t i = 0; i < par.getErrors().size(); ++i) {
+            EXPECT_EQ(par.getErrors()[i].line_number, seq.getErrors()[i].line_number);
+            EXPECT_EQ(par.getErrors()[i].message, seq.getErrors()[i].message);
+        }
+    }
+    std::remove(path.c_str());
+}
+
+// Par défaut, même comportement que la boucle séquentielle de l'application :
+// arrêt à la première ligne invalide, seule erreur reportée
+TEST(ParallelCsvParser, StopsAtFirstInvalidLineLikeSequentialParser) {
+    setLoggingEnabled(false);
+    std::string path = writeSample("tests/data/parallel_malformed.csv", 500);
+
+    CsvParser          seq(path);
+    std::vector<Order> expected;
+    while (auto o = seq.next())
+        expected.push_back(*o);
+    ASSERT_EQ(seq.getErrors().size(), 1u);
+    ASSERT_FALSE(expected.empty());
+
+    for (size_t chunk : { size_t{1}, size_t{100}, size_t{4096} }) {
+        ParallelCsvParser par(path, { 4, chunk, 3, false });
+        std::vector<Order> got;
+        while (auto batch = par.nextBatch())
+            got.insert(got.end(), batch->begin(), batch->end());
+
+        ASSERT_EQ(got.size(), expected.size()) << "bloc " << chunk;
+        for (size_t i = 0; i < got.size(); ++i)
+            ASSERT_EQ(got[i].order_id, expected[i].order_id);
+        ASSERT_EQ(par.getErrors().size(), 1u);
+        EXPECT_EQ(par.getErrors()[0].line_number, seq.getErrors()[0].line_number);
+        EXPECT_EQ(par.getErrors()[0].message, seq.getErrors()[0].message);
+        EXPECT_EQ(par.nextBatch(), nullptr);
+    }
+
+    // ligne invalide dès la première ligne de données : aucun lot
+    ParallelCsvParser invalid("tests/data/input_invalid.csv");
+    EXPECT_EQ(invalid.nextBatch(), nullptr);
+    EXPECT_EQ(invalid.getErrors().size(), 1u);
+    std::remove(path.c_str());
+}
+
+TEST(ParallelCsvParser, OnlyHeaderYieldsNoBatch) {
+    ParallelCsvParser par("tests/data/input_only_header.csv");
+    EXPECT_EQ(par.nextBatch(), nullptr);
+    EXPECT_TRUE(par.getErrors().empty());
+}
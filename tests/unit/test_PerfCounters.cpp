@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <vector>
+#include "PerfCounters.h"
+
+using namespace me;
+
+// Avec ou sans accès aux compteurs : rien n'est levé et le rapport est lisible
+TEST(PerfCounters, DegradesGracefully) {
+    PerfCounters counters;
+    std::vector<uint64_t> v(1 << 16, 1);
+    uint64_t sum = 0;
+    {
+        PerfScope scope(counters);
+        for (auto x : v) sum += x;
+    }
+    EXPECT_EQ(sum, v.size());
+
+    std::ostringstream os;
+    counters.print(os, static_cast<double>(v.size()), "élément");
+    if (!counters.available()) {
+        EXPECT_FALSE(counters.unavailableReason().empty());
+        EXPECT_NE(os.str().find("indisponibles"), std::string::npos);
+        EXPECT_EQ(counters.value(PerfCounters::Cycles), 0.0);
+        return;
+    }
+    EXPECT_NE(os.str().find("cycles"), std::string::npos);
+    if (counters.available(PerfCounters::Instructions)) {
+        EXPECT_GT(counters.value(PerfCounters::Instructions), static_cast<double>(v.size()));
+    }
+}
+
+TEST(PerfCounters, IntervalsAccumulateUntilReset) {
+    PerfCounters counters;
+    if (!counters.available(PerfCounters::Instructions))
+        GTEST_SKIP() << counters.unavailableReason();
+
+    volatile uint64_t sink = 0;
+    counters.start();
+    for (int i = 0; i < 100000; ++i) sink = sink + i;
+    counters.stop();
+    double first = counters.value(PerfCounters::Instructions);
+    counters.start();
+    for (int i = 0; i < 100000; ++i) sink = sink + i;
+    counters.stop();
+    EXPECT_GT(counters.value(PerfCounters::Instructions), first * 1.5);
+
+    counters.reset();
+    EXPECT_EQ(counters.value(PerfCounters::Instructions), 0.0);
+}
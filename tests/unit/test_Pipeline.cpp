@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "Pipeline.h"
+#include "Logger.h"
+
+using namespace me;
+
+namespace {
+    std::vector<Order> randomFlow(size_t n) {
+        std::mt19937_64 rng{11};
+        std::uniform_int_distribution<int> instr{0, 3}, px{95, 105}, qty{1, 20};
+        std::vector<Order> flow;
+        for (uint64_t i = 0; i < n; ++i) {
+            std::string sym  = "PL" + std::to_string(instr(rng));
+            Side        side = (rng() & 1) ? Side::BUY : Side::SELL;
+            if (i % 9 == 0 && i > 5)
+                flow.push_back(Order::makeLimit(i, i - 5, sym, side, 0, 0.0, Action::CANCEL));
+            else
+                flow.push_back(Order::makeLimit(i, i, sym, side, static_cast<uint64_t>(qty(rng)),
+                                                px(rng), Action::NEW));
+        }
+        return flow;
+    }
+}
+
+// Le pipeline produit exactement la sortie d'une boucle séquentielle,
+// y compris avec de petits lots et de petites files (attentes fréquentes)
+TEST(Pipeline, MatchesSequentialLoop) {
+    setLoggingEnabled(false);
+    auto flow = randomFlow(20000);
+
+    MatchingEngine           ref;
+    std::vector<MatchResult> expected;
+    for (auto const& o : flow)
+        ref.process(o, [&](const MatchResult& r) { expected.push_back(r); });
+
+    MatchingEngine engine;
+    Pipeline::Options opts;
+    opts.batchSize   = 7;
+    opts.ringBatches = 2;
+    opts.pinThreads  = false;
+
+    size_t next = 0;
+    auto source = [&](std::vector<Order>& batch) {
+        while (batch.size() < 7 && next < flow.size())
+            batch.push_back(flow[next++]);
+        return next < flow.size();
+    };
+    std::vector<MatchResult> got;
+    auto stats = Pipeline(engine, opts).run(source, [&](const MatchResult& r) { got.push_back(r); });
+
+    ASSERT_EQ(got.size(), expected.size());
+    for (size_t i = 0; i < got.size(); ++i) {
+        ASSERT_EQ(got[i].order_id, expected[i].order_id) << i;
+        ASSERT_EQ(got[i].status, expected[i].status) << i;
+        ASSERT_EQ(got[i].executed_quantity, expected[i].executed_quantity) << i;
+    }
+    EXPECT_EQ(stats.stages[0].items, flow.size());
+    EXPECT_EQ(stats.stages[1].items, flow.size());
+    EXPECT_EQ(stats.stages[2].items, expected.size());
+    EXPECT_LE(stats.queues[0].maxOccupancy, stats.queues[0].capacity);
+}
+
+// Une exception d'un étage arrête le pipeline et remonte à l'appelant
+TEST(Pipeline, PropagatesStageFailure) {
+    MatchingEngine engine;
+    Pipeline::Options opts;
+    opts.pinThreads = false;
+    int calls = 0;
+    auto source = [&](std::vector<Order>& batch) {
+        if (++calls == 3) throw std::runtime_error("source en panne");
+        batch.push_back(Order::makeLimit(calls, calls, "PLX", Side::BUY, 1, 1.0, Action::NEW));
+        return true;
+    };
+    EXPECT_THROW(Pipeline(engine, opts).run(source, [](const MatchResult&) {}), std::runtime_error);
+}
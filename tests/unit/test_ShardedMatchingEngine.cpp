@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "ShardedMatchingEngine.h"
+#include "Logger.h"
+
+using namespace me;
+
+namespace {
+    // Flux multi-instruments avec fills, MODIFY, CANCEL et MARKET
+    std::vector<Order> randomFlow(size_t n) {
+        std::mt19937_64 rng{3};
+        std::uniform_int_distribution<int> instr{0, 6}, px{95, 105}, qty{1, 20}, kind{0, 9};
+        std::vector<Order> flow;
+        for (uint64_t i = 0; i < n; ++i) {
+            std::string sym  = "SH" + std::to_string(instr(rng));
+            Side        side = (rng() & 1) ? Side::BUY : Side::SELL;
+            int         k    = kind(rng);
+            if (k == 0 && i > 10)
+                flow.push_back(Order::makeLimit(i, i - 10, sym, side, 0, 0.0, Action::CANCEL));
+            else if (k == 1)
+                flow.push_back(Order::makeMarket(i, i, sym, side, static_cast<uint64_t>(qty(rng)), Action::NEW));
+            else
+                flow.push_back(Order::makeLimit(i, i, sym, side, static_cast<uint64_t>(qty(rng)),
+                                                px(rng), Action::NEW));
+        }
+        return flow;
+    }
+
+    bool sameResult(const MatchResult& a, const MatchResult& b) {
+        return a.order_id == b.order_id && a.instrument == b.instrument
+            && a.status == b.status && a.quantity == b.quantity
+            && a.executed_quantity == b.executed_quantity
+            && a.execution_price == b.execution_price
+            && a.counterparty_id == b.counterparty_id;
+    }
+}
+
+// La sortie répartie est identique, ordre compris, à celle d'un moteur unique
+TEST(ShardedMatchingEngine, MatchesSingleEngineOutput) {
+    setLoggingEnabled(false);
+    auto flow = randomFlow(20000);
+
+    MatchingEngine ref;
+    std::vector<MatchResult> expected;
+    for (auto const& o : flow)
+        ref.process(o, [&](const MatchResult& r) { expected.push_back(r); });
+
+    // petites files : force les situations de file pleine des deux côtés
+    ShardedMatchingEngine eng({ 3, 16, false, 0 });
+    std::vector<MatchResult> got;
+    auto sink = [&](const MatchResult& r) { got.push_back(r); };
+    for (auto const& o : flow)
+        eng.submit(o, sink);
+    eng.flush(sink);
+
+    ASSERT_EQ(got.size(), expected.size());
+    for (size_t i = 0; i < got.size(); ++i)
+        ASSERT_TRUE(sameResult(got[i], expected[i])) << "résultat " << i;
+}
+
+// Un instrument est toujours traité par le même shard
+TEST(ShardedMatchingEngine, RoutesInstrumentToFixedShard) {
+    ShardedMatchingEngine eng({ 4, 16, false, 0 });
+    Symbol s("ROUTE");
+    EXPECT_EQ(eng.shardOf(s), eng.shardOf(Symbol("ROUTE")));
+    EXPECT_LT(eng.shardOf(s), eng.shardCount());
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "SymbolTable.h"
+#include "Order.h"
+
+using namespace me;
+
+// Un même nom donne toujours le même id, des noms différents des ids différents
+TEST(SymbolTable, InternIsStable) {
+    SymbolTable t;
+    SymbolId a = t.intern("AAPL");
+    SymbolId g = t.intern("GOOG");
+    EXPECT_NE(a, g);
+    EXPECT_EQ(t.intern("AAPL"), a);
+    EXPECT_EQ(t.name(g), "GOOG");
+    EXPECT_EQ(t.name(0), "");          // id 0 réservé au nom vide
+    EXPECT_FALSE(t.find("MSFT").has_value());
+}
+
+// Les ids sont denses : ils peuvent indexer un tableau de carnets
+TEST(SymbolTable, IdsAreDense) {
+    SymbolTable t;
+    for (int i = 0; i < 3000; ++i)
+        EXPECT_EQ(t.intern("SYM" + std::to_string(i)), static_cast<SymbolId>(i + 1));
+    EXPECT_EQ(t.size(), 3001u);
+    EXPECT_EQ(t.name(2500), "SYM2499");
+}
+
+// Interning concurrent : chaque nom reçoit un seul id
+TEST(SymbolTable, ConcurrentInternAgrees) {
+    SymbolTable t;
+    std::vector<std::vector<SymbolId>> seen(4);
+    std::vector<std::thread> threads;
+    for (size_t k = 0; k < seen.size(); ++k)
+        threads.emplace_back([&, k] {
+            for (int i = 0; i < 2000; ++i)
+                seen[k].push_back(t.intern("X" + std::to_string(i)));
+        });
+    for (auto& th : threads) th.join();
+    for (size_t k = 1; k < seen.size(); ++k)
+        EXPECT_EQ(seen[k], seen[0]);
+    EXPECT_EQ(t.size(), 2001u);
+}
+
+// Symbol : 4 octets dans Order, comparable et affichable par son nom
+TEST(Symbol, BehavesLikeItsName) {
+    Order o = Order::makeLimit(1, 1, "AAPL", Side::BUY, 10, 1.0, Action::NEW);
+    EXPECT_EQ(o.instrument, "AAPL");
+    EXPECT_EQ(o.instrument, Symbol("AAPL"));
+    EXPECT_EQ(o.instrument.name(), "AAPL");
+    EXPECT_TRUE(Symbol{}.empty());
+    EXPECT_EQ(sizeof(Symbol), sizeof(SymbolId));
+}
@@ -0,0 +1,91 @@
+#include "BenchReport.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// Usage : benchcmp <référence.json> <candidat.json> [--threshold P] [--all]
+// Compare deux rapports de bench (BenchReport, ou sortie JSON de Google Benchmark)
+// métrique par métrique : moyennes des passes, variation relative et intervalle de
+// confiance à 95 % (test de Welch). Une variation est signalée si l'intervalle exclut
+// zéro et dépasse le seuil (2 % par défaut) ; sans passes répétées (--repeat,
+// --benchmark_repetitions) le verdict reste « ? ».
+//   --threshold P : seuil de variation en %, en deçà duquel un écart est ignoré
+//   --all         : affiche aussi les métriques inchangées
+// Code de retour : 0 sans régression, 1 si au moins une régression significative.
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage : " << argv[0] << " <référence.json> <candidat.json> [--threshold P] [--all]\n";
+        return 2;
+    }
+    try {
+        double threshold = 0.02;
+        bool   all       = false;
+        for (int i = 3; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--threshold" && i + 1 < argc) threshold = std::stod(argv[++i]) / 100.0;
+            else if (arg == "--all")                  all = true;
+            else
+                throw std::runtime_error("Argument inconnu : " + arg);
+        }
+
+        me::BenchReport base = me::BenchReport::readFile(argv[1]);
+        me::BenchReport cand = me::BenchReport::readFile(argv[2]);
+
+        std::cout << "référence : " << base.benchmark() << " @ " << base.gitRevision() << " (" << base.cpuModel() << ")\n"
+                  << "candidat  : " << cand.benchmark() << " @ " << cand.gitRevision() << " (" << cand.cpuModel() << ")\n";
+        if (base.cpuModel() != cand.cpuModel())
+            std::cout << "attention : modèles de CPU différents, comparaison peu fiable\n";
+
+        size_t width = 10;
+        for (const auto& m : cand.metrics())
+            width = std::max(width, m.name.size());
+
+        std::cout << '\n' << std::setfill(' ') << std::left << std::setw(static_cast<int>(width)) << "métrique"
+                  << std::right << std::setw(15) << "référence" << std::setw(15) << "candidat"
+                  << std::setw(10) << "écart" << std::setw(22) << "IC 95 %" << "  verdict\n";
+
+        size_t regressions = 0, improvements = 0, unchanged = 0, inconclusive = 0, missing = 0;
+        for (const auto& m : cand.metrics()) {
+            const me::BenchReport::Metric* ref = base.find(m.name);
+            if (!ref) { ++missing; continue; }
+
+            me::MetricComparison c = me::compareMetric(*ref, m, threshold);
+            switch (c.verdict) {
+                case me::MetricComparison::Regression:   ++regressions;  break;
+                case me::MetricComparison::Improvement:  ++improvements; break;
+                case me::MetricComparison::Unchanged:    ++unchanged;    break;
+                case me::MetricComparison::Inconclusive: ++inconclusive; break;
+            }
+            if (!all && c.verdict == me::MetricComparison::Unchanged)
+                continue;
+
+            std::ostringstream ci;
+            ci << std::showpos << std::fixed << std::setprecision(1)
+               << '[' << c.ciLow * 100 << ", " << c.ciHigh * 100 << "] %";
+            std::cout << std::left << std::setw(static_cast<int>(width)) << m.name << std::right
+                      << std::defaultfloat << std::setprecision(6)
+                      << std::setw(15) << c.baseMean << std::setw(15) << c.candMean
+                      << std::showpos << std::fixed << std::setprecision(1)
+                      << std::setw(9) << c.change * 100 << '%' << std::noshowpos << std::defaultfloat
+                      << std::setw(22) << (c.verdict == me::MetricComparison::Inconclusive ||
+                                           std::isinf(c.change) ? "-" : ci.str())
+                      << "  " << me::toString(c.verdict) << " (" << m.samples.size() << " / "
+                      << ref->samples.size() << " passes, " << (m.higherIsBetter ? "plus haut" : "plus bas")
+                      << " = mieux)\n";
+        }
+
+        std::cout << '\n' << regressions << " régression(s), " << improvements << " amélioration(s), "
+                  << unchanged << " inchangée(s), " << inconclusive << " non concluante(s)";
+        if (missing)
+            std::cout << ", " << missing << " absente(s) de la référence";
+        std::cout << " ; seuil " << threshold * 100 << " %\n";
+        return regressions ? 1 : 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Erreur fatale : " << e.what() << "\n";
+        return 2;
+    }
+}
@@ -0,0 +1,39 @@
+#include "BinaryReader.h"
+#include "CsvWriter.h"
+#include <iostream>
+#include <string>
+
+// Usage : bin2csv <entrée.bin> <sortie.csv>
+// Reconvertit en CSV un fichier binaire d'ordres (format de data/input.csv)
+// ou de résultats (format de data/output.csv), détecté par son en-tête.
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::cerr << "Usage : " << argv[0] << " <entrée.bin> <sortie.csv>\n";
+        return 2;
+    }
+    try {
+        size_t n = 0;
+        if (me::isBinaryResultFile(argv[1])) {
+            me::BinaryResultReader reader(argv[1]);
+            me::CsvWriter          writer(argv[2]);
+            while (auto r = reader.next()) {
+                writer.write(*r);
+                ++n;
+            }
+        }
+        else {
+            me::BinaryOrderReader reader(argv[1]);
+            me::CsvOrderWriter    writer(argv[2]);
+            while (auto o = reader.next()) {
+                writer.write(*o);
+                ++n;
+            }
+        }
+        std::cout << n << " enregistrements convertis\n";
+        return 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Erreur fatale : " << e.what() << "\n";
+        return 1;
+    }
+}
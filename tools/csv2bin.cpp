@@ -0,0 +1,43 @@
+#include "ParallelCsvParser.h"
+#include "BinaryWriter.h"
+#include "Logger.h"
+#include <iostream>
+#include <string>
+
+// Usage : csv2bin <entrée.csv> <sortie.bin> [--parse-threads N]
+// Convertit un CSV d'ordres au format binaire ; les lignes invalides sont signalées et sautées.
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage : " << argv[0] << " <entrée.csv> <sortie.bin> [--parse-threads N]\n";
+        return 2;
+    }
+    try {
+        me::ParallelCsvParser::Options opts;
+        opts.skipInvalid = true;
+        for (int i = 3; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--parse-threads" && i + 1 < argc)
+                opts.threads = std::stoul(argv[++i]);
+            else
+                throw std::runtime_error("Argument inconnu : " + arg);
+        }
+        me::setLoggingEnabled(false);
+
+        me::ParallelCsvParser   parser(argv[1], opts);
+        me::BinaryOrderWriter   writer(argv[2]);
+        while (auto batch = parser.nextBatch())
+            for (auto const& o : *batch)
+                writer.write(o);
+        writer.close();
+
+        for (auto const& e : parser.getErrors())
+            std::cerr << "Ligne " << e.line_number << " : " << e.message << "\n";
+        std::cout << writer.count() << " ordres écrits, "
+                  << parser.getErrors().size() << " lignes rejetées\n";
+        return 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Erreur fatale : " << e.what() << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,76 @@
+#include "OrderFlowGenerator.h"
+#include "BinaryWriter.h"
+#include "CsvWriter.h"
+#include "Logger.h"
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+
+// Usage : genflow <sortie.csv|sortie.bin> [--orders N] [--instruments K] [--zipf S]
+//                 [--mix NEW,MARKET,MODIFY,CANCEL] [--seed S]
+// Écrit un flux d'ordres synthétique (voir OrderFlowGenerator) au format de
+// data/input.csv, ou au format binaire si la sortie finit par ".bin". Un moteur
+// fantôme traite le flux au fil de l'eau : MODIFY et CANCEL visent de vrais
+// ordres au repos.
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage : " << argv[0] << " <sortie.csv|sortie.bin> [--orders N] [--instruments K]"
+                     " [--zipf S] [--mix NEW,MARKET,MODIFY,CANCEL] [--seed S]\n";
+        return 2;
+    }
+    try {
+        std::string path = argv[1];
+        size_t      n    = 1000000;
+        me::OrderFlowGenerator::Options opts;
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--orders" && i + 1 < argc)           n = std::stoul(argv[++i]);
+            else if (arg == "--instruments" && i + 1 < argc) opts.instruments  = std::stoul(argv[++i]);
+            else if (arg == "--zipf" && i + 1 < argc)        opts.zipfExponent = std::stod(argv[++i]);
+            else if (arg == "--seed" && i + 1 < argc)        opts.seed         = std::stoull(argv[++i]);
+            else if (arg == "--mix" && i + 1 < argc) {
+                std::istringstream in(argv[++i]);
+                char c1, c2, c3;
+                if (!(in >> opts.newLimit >> c1 >> opts.market >> c2 >> opts.modify >> c3 >> opts.cancel)
+                    || c1 != ',' || c2 != ',' || c3 != ',')
+                    throw std::runtime_error("--mix attend quatre proportions : NEW,MARKET,MODIFY,CANCEL");
+            }
+            else
+                throw std::runtime_error("Argument inconnu : " + arg);
+        }
+        me::setLoggingEnabled(false);
+
+        me::OrderFlowGenerator gen(opts);
+        me::MatchingEngine     shadow;
+        gen.registerInstruments(shadow);
+
+        std::optional<me::CsvOrderWriter>    csv;
+        std::optional<me::BinaryOrderWriter> binary;
+        if (path.size() > 4 && path.compare(path.size() - 4, 4, ".bin") == 0) binary.emplace(path);
+        else                                                                  csv.emplace(path);
+
+        size_t counts[me::OrderFlowGenerator::kKinds] = {};
+        for (size_t i = 0; i < n; ++i) {
+            me::Order o = gen.next();
+            shadow.process(o, [&](const me::MatchResult& r) { gen.observe(r); });
+            if (csv) csv->write(o);
+            else     binary->write(o);
+            ++counts[static_cast<size_t>(me::OrderFlowGenerator::kindOf(o))];
+        }
+        if (csv) csv->close();
+        else     binary->close();
+
+        std::cout << n << " ordres écrits dans " << path << " :";
+        for (size_t k = 0; k < me::OrderFlowGenerator::kKinds; ++k)
+            std::cout << (k ? ", " : " ")
+                      << me::OrderFlowGenerator::toString(static_cast<me::OrderFlowGenerator::Kind>(k))
+                      << ' ' << counts[k];
+        std::cout << " ; " << gen.liveOrders() << " ordres au repos à la fin\n";
+        return 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Erreur fatale : " << e.what() << "\n";
+        return 1;
+    }
+}